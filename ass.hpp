@@ -25,260 +25,4076 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace ass {
 
+    /**
+     * Memory held by the connection bookkeeping and callback of a single Signal or Slot.
+     *
+     * State bytes are the delivery state of a Signal, with its hash ring, delivery filters and
+     * buffered emissions, or the receiver of a Slot bound to an Executor. Memory owned by the
+     * buffered arguments themselves is not counted.
+     */
+    struct MemoryUsage {
+        std::size_t connectionBytes = 0;
+        std::size_t slackBytes = 0;
+        std::size_t callbackBytes = 0;
+        std::size_t stateBytes = 0;
+
+        std::size_t totalBytes() const {
+            return connectionBytes + slackBytes + callbackBytes + stateBytes;
+        }
+    };
+
+    /**
+     * Memory held by all Signals and Slots in the process.
+     *
+     * Connection bytes are the allocated capacity of every connection list, including slack. The
+     * state bytes of MemoryUsage are not tracked process wide.
+     */
+    struct ProcessMemoryUsage {
+        std::size_t connectionBytes = 0;
+        std::size_t callbackBytes = 0;
+
+        std::size_t totalBytes() const {
+            return connectionBytes + callbackBytes;
+        }
+    };
+
+    namespace detail {
+
+        struct MemoryCounters {
+            std::atomic<std::size_t> connectionBytes{0};
+            std::atomic<std::size_t> callbackBytes{0};
+        };
+
+        inline MemoryCounters &memoryCounters() {
+            static MemoryCounters counters;
+            return counters;
+        }
+
+        /**
+         * Allocator for connection lists that keeps the process wide connection byte count.
+         */
+        template<typename T>
+        struct TrackingAllocator {
+
+            using value_type = T;
+
+            TrackingAllocator() = default;
+
+            template<typename U>
+            TrackingAllocator(const TrackingAllocator<U> &) noexcept {}
+
+            T *allocate(std::size_t n) {
+                T *p = std::allocator<T>().allocate(n);
+                memoryCounters().connectionBytes.fetch_add(n * sizeof(T), std::memory_order_relaxed);
+                return p;
+            }
+
+            void deallocate(T *p, std::size_t n) noexcept {
+                memoryCounters().connectionBytes.fetch_sub(n * sizeof(T), std::memory_order_relaxed);
+                std::allocator<T>().deallocate(p, n);
+            }
+
+            template<typename U>
+            bool operator==(const TrackingAllocator<U> &) const noexcept { return true; }
+
+            template<typename U>
+            bool operator!=(const TrackingAllocator<U> &) const noexcept { return false; }
+        };
+
+        template<typename T>
+        using ConnectionList = std::vector<T, TrackingAllocator<T>>;
+
+        /**
+         * Vector of trivially copyable values that stores up to N values inside itself before
+         * allocating, so that connecting within the inline capacity does not allocate.
+         */
+        template<typename T, std::size_t N>
+        class SmallVector {
+
+            static_assert(std::is_trivially_copyable<T>::value, "SmallVector values must be trivially copyable");
+            static_assert(N > 0, "SmallVector inline capacity must be greater than zero");
+
+        public:
+
+            using value_type = T;
+            using iterator = T *;
+            using const_iterator = const T *;
+
+            SmallVector() = default;
+
+            SmallVector(const SmallVector &) = delete;
+
+            SmallVector &operator=(const SmallVector &) = delete;
+
+            ~SmallVector() {
+                release();
+            }
+
+            iterator begin() { return data(); }
+
+            iterator end() { return data() + count; }
+
+            const_iterator begin() const { return data(); }
+
+            const_iterator end() const { return data() + count; }
+
+            std::size_t size() const { return count; }
+
+            std::size_t capacity() const { return reserved; }
+
+            bool empty() const { return count == 0; }
+
+            T &operator[](std::size_t index) { return data()[index]; }
+
+            const T &operator[](std::size_t index) const { return data()[index]; }
+
+            T &back() { return data()[count - 1]; }
+
+            void push_back(const T &value) {
+                if (count == reserved) {
+                    reallocate(reserved * 2);
+                }
+                data()[count++] = value;
+            }
+
+            void pop_back() {
+                --count;
+            }
+
+            iterator insert(const_iterator position, const T &value) {
+                auto index = position - begin();
+                if (count == reserved) {
+                    reallocate(reserved * 2);
+                }
+                auto *values = data();
+                std::copy_backward(values + index, values + count, values + count + 1);
+                values[index] = value;
+                ++count;
+                return values + index;
+            }
+
+            iterator erase(const_iterator first, const_iterator last) {
+                auto *values = data();
+                auto from = first - values;
+                auto to = last - values;
+                std::copy(values + to, values + count, values + from);
+                count -= to - from;
+                return values + from;
+            }
+
+            void clear() {
+                count = 0;
+            }
+
+            void reserve(std::size_t capacity) {
+                if (capacity > reserved) {
+                    reallocate(capacity);
+                }
+            }
+
+            void shrink_to_fit() {
+                if (heap == nullptr || count == reserved) {
+                    return;
+                }
+                if (count > N) {
+                    reallocate(count);
+                    return;
+                }
+                std::copy(heap, heap + count, inlineData());
+                release();
+                reserved = N;
+            }
+
+        private:
+
+            T *inlineData() { return reinterpret_cast<T *>(&storage); }
+
+            const T *inlineData() const { return reinterpret_cast<const T *>(&storage); }
+
+            T *data() { return heap ? heap : inlineData(); }
+
+            const T *data() const { return heap ? heap : inlineData(); }
+
+            void reallocate(std::size_t capacity) {
+                T *allocated = TrackingAllocator<T>().allocate(capacity);
+                std::copy(data(), data() + count, allocated);
+                release();
+                heap = allocated;
+                reserved = capacity;
+            }
+
+            void release() {
+                if (heap != nullptr) {
+                    TrackingAllocator<T>().deallocate(heap, reserved);
+                    heap = nullptr;
+                }
+            }
+
+        private:
+
+            typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type storage;
+            T *heap = nullptr;
+            std::size_t count = 0;
+            std::size_t reserved = N;
+        };
+
+        template<typename Container>
+        MemoryUsage connectionListUsage(const Container &list) {
+            using T = typename Container::value_type;
+            MemoryUsage usage;
+            usage.connectionBytes = list.size() * sizeof(T);
+            usage.slackBytes = (list.capacity() - list.size()) * sizeof(T);
+            return usage;
+        }
+
+        /**
+         * Returns the heap bytes a std::function uses to store a callable of type F, or 0 when the
+         * callable is stored inside the std::function itself.
+         */
+        template<typename F, typename Function>
+        std::size_t callbackHeapBytes(const Function &function) {
+            auto *target = reinterpret_cast<const char *>(function.template target<F>());
+            auto *begin = reinterpret_cast<const char *>(&function);
+            std::less<const char *> less;
+            if (target == nullptr || (!less(target, begin) && less(target, begin + sizeof(Function)))) {
+                return 0;
+            }
+            return sizeof(F);
+        }
+    }
+
+    /**
+     * Returns the memory currently held by all Signals and Slots in the process.
+     *
+     * @return Process wide memory usage.
+     */
+    inline ProcessMemoryUsage processMemoryUsage() {
+        ProcessMemoryUsage usage;
+        usage.connectionBytes = detail::memoryCounters().connectionBytes.load(std::memory_order_relaxed);
+        usage.callbackBytes = detail::memoryCounters().callbackBytes.load(std::memory_order_relaxed);
+        return usage;
+    }
+
+    /**
+     * Type used to pass an argument of type T to emit and to Slot functions. Small trivially
+     * copyable types are passed by value and everything else by const reference, so that emitting
+     * never copies an argument per connected Slot. Reference types are passed as declared, so an
+     * rvalue reference argument reaches every Slot as an rvalue and a Slot may move from it.
+     */
+    template<typename T>
+    using Parameter = typename std::conditional<
+            std::is_reference<T>::value ||
+            (std::is_trivially_copyable<T>::value && sizeof(T) <= 2 * sizeof(void *)),
+            T, const T &>::type;
+
+    /**
+     * Type used to hold an argument of type T beyond the emit that passed it, e.g. for queued
+     * delivery. This is the only point at which an argument is copied.
+     */
+    template<typename T>
+    using Owned = typename std::decay<T>::type;
+
+    /**
+     * Returns an owned copy of an argument so that it can be held beyond the emit that passed it.
+     *
+     * @param value Argument to copy.
+     * @return Owned copy of the argument.
+     */
+    template<typename T>
+    Owned<T> own(const T &value) {
+        return value;
+    }
+
+    /**
+     * Contiguous sequence of T that is emitted as a view of memory owned by the caller, e.g. an I/O
+     * buffer, and only copied if a receiver needs to keep it.
+     *
+     * Receivers that use the Payload during the emit read the caller's memory directly. A receiver
+     * that keeps the Payload for later or for another thread calls escape(), which copies the data
+     * into a reference counted buffer on the first call. Every later escape() and receiver then
+     * shares that buffer. escape() must be called while the emit is in progress, from the emitting
+     * thread.
+     */
+    template<typename T>
+    class Payload {
+    public:
+
+        Payload() = default;
+
+        Payload(const T *data, std::size_t size)
+                : pointer(data), length(size) {}
+
+        const T *data() const { return pointer; }
+
+        std::size_t size() const { return length; }
+
+        bool empty() const { return length == 0; }
+
+        const T *begin() const { return pointer; }
+
+        const T *end() const { return pointer + length; }
+
+        const T &operator[](std::size_t index) const { return pointer[index]; }
+
+        /**
+         * Returns true if this Payload holds a reference to its own copy of the data.
+         *
+         * @return true if owned.
+         */
+        bool isOwned() const {
+            return owner != nullptr;
+        }
+
+        /**
+         * Returns a Payload that owns its data, copying the viewed data on the first call only.
+         *
+         * @return Owned Payload sharing the same buffer as this Payload.
+         */
+        Payload escape() const {
+            if (!owner) {
+                owner = std::make_shared<const std::vector<T>>(pointer, pointer + length);
+                pointer = owner->data();
+            }
+            return *this;
+        }
+
+    private:
+
+        mutable const T *pointer = nullptr;
+        std::size_t length = 0;
+        mutable std::shared_ptr<const std::vector<T>> owner;
+    };
+
+    /**
+     * Returns an owned Payload, copying the viewed data only if no receiver has escaped it yet.
+     *
+     * @param payload Payload to own.
+     * @return Owned Payload.
+     */
+    template<typename T>
+    Payload<T> own(const Payload<T> &payload) {
+        return payload.escape();
+    }
+
+    namespace detail {
+
+        /**
+         * Reference counted, immutable arguments of a single emission, shared by every queued
+         * receiver of that emission.
+         */
+        struct Envelope {
+            std::atomic<int> references{0};
+            void (*recycle)(Envelope *) = nullptr;
+
+            void retain() {
+                references.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void release() {
+                if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    recycle(this);
+                }
+            }
+        };
+
+        template<typename... Args>
+        class EnvelopePool;
+
+        template<typename... Args>
+        struct ArgumentEnvelope final : Envelope {
+
+            using Arguments = std::tuple<Owned<Args>...>;
+
+            Arguments &arguments() {
+                return *reinterpret_cast<Arguments *>(&storage);
+            }
+
+            typename std::aligned_storage<sizeof(Arguments), alignof(Arguments)>::type storage;
+            EnvelopePool<Args...> *pool = nullptr;
+            ArgumentEnvelope *next = nullptr;
+        };
+
+        /**
+         * Per thread free list of envelopes, so that queued emission does not allocate once the
+         * pool has grown to the number of emissions in flight.
+         *
+         * Envelopes released on another thread are pushed onto a lock free stack that the owning
+         * thread takes back when its own list is empty. The pool is reference counted by its thread
+         * and by every envelope in use, so it outlives its thread until they have all been released.
+         */
+        template<typename... Args>
+        class EnvelopePool {
+
+            using EnvelopeType = ArgumentEnvelope<Args...>;
+
+        public:
+
+            static EnvelopeType *acquire(Parameter<Args>... args) {
+                auto &pool = *owner().pool;
+                auto *envelope = pool.pop();
+                new(&envelope->storage) typename EnvelopeType::Arguments(own(args)...);
+                envelope->references.store(1, std::memory_order_relaxed);
+                pool.references.fetch_add(1, std::memory_order_relaxed);
+                return envelope;
+            }
+
+        private:
+
+            struct Owner {
+                Owner() : pool(new EnvelopePool()) {
+                    local() = pool;
+                }
+
+                ~Owner() {
+                    local() = nullptr;
+                    pool->drop();
+                }
+
+                EnvelopePool *pool;
+            };
+
+            EnvelopePool() = default;
+
+            ~EnvelopePool() {
+                destroy(free);
+                destroy(returned.load(std::memory_order_acquire));
+            }
+
+            static Owner &owner() {
+                static thread_local Owner owner;
+                return owner;
+            }
+
+            static EnvelopePool *&local() {
+                static thread_local EnvelopePool *pool = nullptr;
+                return pool;
+            }
+
+            static void recycle(Envelope *released) {
+                auto *envelope = static_cast<EnvelopeType *>(released);
+                using Arguments = typename EnvelopeType::Arguments;
+                envelope->arguments().~Arguments();
+
+                auto *pool = envelope->pool;
+                if (local() == pool) {
+                    envelope->next = pool->free;
+                    pool->free = envelope;
+                } else {
+                    auto *head = pool->returned.load(std::memory_order_relaxed);
+                    do {
+                        envelope->next = head;
+                    } while (!pool->returned.compare_exchange_weak(head, envelope, std::memory_order_release,
+                                                                   std::memory_order_relaxed));
+                }
+                pool->drop();
+            }
+
+            static void destroy(EnvelopeType *envelope) {
+                while (envelope != nullptr) {
+                    auto *next = envelope->next;
+                    delete envelope;
+                    envelope = next;
+                }
+            }
+
+            EnvelopeType *pop() {
+                if (free == nullptr) {
+                    free = returned.exchange(nullptr, std::memory_order_acquire);
+                }
+                if (free == nullptr) {
+                    auto *envelope = new EnvelopeType();
+                    envelope->pool = this;
+                    envelope->recycle = &EnvelopePool::recycle;
+                    return envelope;
+                }
+                auto *envelope = free;
+                free = envelope->next;
+                return envelope;
+            }
+
+            void drop() {
+                if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    delete this;
+                }
+            }
+
+        private:
+
+            std::atomic<int> references{1};
+            EnvelopeType *free = nullptr;
+            std::atomic<EnvelopeType *> returned{nullptr};
+        };
+
+        /**
+         * Releases the envelope of an emission once every queued receiver has been posted.
+         */
+        template<typename... Args>
+        struct EmissionEnvelope {
+
+            EmissionEnvelope() = default;
+
+            EmissionEnvelope(EmissionEnvelope &&other) noexcept : envelope(other.envelope) {
+                other.envelope = nullptr;
+            }
+
+            EmissionEnvelope &operator=(EmissionEnvelope &&) = delete;
+
+            ~EmissionEnvelope() {
+                if (envelope != nullptr) {
+                    envelope->release();
+                }
+            }
+
+            ArgumentEnvelope<Args...> *get(Parameter<Args>... args) {
+                if (envelope == nullptr) {
+                    envelope = EnvelopePool<Args...>::acquire(std::forward<Parameter<Args>>(args)...);
+                }
+                return envelope;
+            }
+
+            ArgumentEnvelope<Args...> *envelope = nullptr;
+        };
+
+        /**
+         * Receiver whose delivery is running on this thread, innermost first.
+         */
+        inline const void *&runningReceiver() {
+            static thread_local const void *receiver = nullptr;
+            return receiver;
+        }
+
+        /**
+         * Target of queued deliveries to a Slot. The Slot detaches itself when destroyed so that
+         * deliveries still queued are dropped rather than calling a destroyed Slot.
+         *
+         * Deliveries may run concurrently on several threads, so before the Slot is moved or
+         * destroyed the receiver is paused: deliveries that have not started wait, and pausing
+         * waits until none is still calling the Slot.
+         */
+        template<typename Slot>
+        struct Receiver {
+
+            explicit Receiver(const Slot *slot) : slot(slot) {}
+
+            const Slot *enter() {
+                std::unique_lock<std::mutex> guard(mutex);
+                resumed.wait(guard, [&]() { return !paused; });
+                if (slot != nullptr) {
+                    ++active;
+                }
+                return slot;
+            }
+
+            void leave() {
+                std::lock_guard<std::mutex> guard(mutex);
+                if (--active == 0) {
+                    idle.notify_all();
+                }
+            }
+
+            void pause() {
+                assert(runningReceiver() != this && "a queued Slot function must not move or destroy its own Slot");
+                std::unique_lock<std::mutex> guard(mutex);
+                paused = true;
+                idle.wait(guard, [&]() { return active == 0; });
+            }
+
+            void resume(const Slot *target) {
+                {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    slot = target;
+                    paused = false;
+                }
+                resumed.notify_all();
+            }
+
+            std::mutex mutex;
+            std::condition_variable idle;
+            std::condition_variable resumed;
+            std::size_t active = 0;
+            bool paused = false;
+            const Slot *slot;
+            std::atomic<std::size_t> pending{0};
+        };
+
+        /**
+         * Calls the provided function with owned arguments, each passed as its Parameter type.
+         */
+        template<typename... Args, typename Function, std::size_t... I>
+        decltype(auto) apply(const Function &function, std::tuple<Owned<Args>...> &arguments,
+                             std::index_sequence<I...>) {
+            return function(static_cast<Parameter<Args>>(std::get<I>(arguments))...);
+        }
+
+        /**
+         * Type used to pass an owned argument of type T that is shared by several Slots. An rvalue
+         * reference gets a copy of its own, so that no Slot moves from the argument of another.
+         */
+        template<typename T>
+        using Shared = typename std::conditional<
+                std::is_rvalue_reference<T>::value, Owned<T>, Parameter<T>>::type;
+
+        /**
+         * Calls the provided function with owned arguments shared by several Slots, each passed as
+         * its Shared type.
+         */
+        template<typename... Args, typename Function, std::size_t... I>
+        decltype(auto) applyShared(const Function &function, std::tuple<Owned<Args>...> &arguments,
+                                   std::index_sequence<I...>) {
+            return function(static_cast<Shared<Args>>(std::get<I>(arguments))...);
+        }
+
+        inline std::uint64_t mix(std::uint64_t x) {
+            x += 0x9e3779b97f4a7c15ull;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+            return x ^ (x >> 31);
+        }
+    }
+
+    /**
+     * Queued delivery of one emission to one Slot.
+     */
+    class Task {
+    public:
+
+        Task() = default;
+
+        Task(void (*run)(void *, detail::Envelope *), std::shared_ptr<void> receiver, detail::Envelope *envelope,
+             std::size_t key = 0)
+                : run(run), receiver(std::move(receiver)), envelope(envelope), hash(key) {}
+
+        Task(Task &&other) noexcept
+                : run(other.run), receiver(std::move(other.receiver)), envelope(other.envelope), hash(other.hash) {
+            other.envelope = nullptr;
+        }
+
+        Task &operator=(Task &&other) noexcept {
+            std::swap(run, other.run);
+            std::swap(receiver, other.receiver);
+            std::swap(envelope, other.envelope);
+            std::swap(hash, other.hash);
+            return *this;
+        }
+
+        ~Task() {
+            if (envelope != nullptr) {
+                envelope->release();
+            }
+        }
+
+        void operator()() {
+            run(receiver.get(), envelope);
+        }
+
+        /**
+         * Returns the ordering key of this delivery. Deliveries with the same key are to be run in
+         * the order they were posted.
+         *
+         * @return Ordering key.
+         */
+        std::size_t key() const {
+            return hash;
+        }
+
+    private:
+
+        void (*run)(void *, detail::Envelope *) = nullptr;
+        std::shared_ptr<void> receiver;
+        detail::Envelope *envelope = nullptr;
+        std::size_t hash = 0;
+    };
+
+    /**
+     * Runs queued deliveries for the Slots bound to it.
+     */
+    class Executor {
+    public:
+
+        virtual ~Executor() = default;
+
+        /**
+         * Queues a delivery to be run later, possibly on another thread.
+         *
+         * @param task Delivery to run.
+         */
+        virtual void post(Task task) = 0;
+    };
+
+    /**
+     * Executor that queues deliveries until a consumer thread calls dispatch().
+     *
+     * Only one thread may dispatch at a time. Queue storage is reused, so posting does not allocate
+     * once the queue has grown to the largest number of pending deliveries.
+     */
+    class EventQueue final : public Executor {
+    public:
+
+        void post(Task task) override {
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                pending.push_back(std::move(task));
+            }
+            available.notify_one();
+        }
+
+        /**
+         * Runs all deliveries queued so far.
+         *
+         * @return Number of deliveries run.
+         */
+        std::size_t dispatch() {
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                std::swap(pending, running);
+            }
+            for (auto &task : running) {
+                task();
+            }
+            auto count = running.size();
+            running.clear();
+            return count;
+        }
+
+        /**
+         * Waits until a delivery is queued or the timeout expires.
+         *
+         * @param timeout Longest time to wait.
+         * @return true if a delivery is queued.
+         */
+        template<typename Rep, typename Period>
+        bool wait(const std::chrono::duration<Rep, Period> &timeout) {
+            std::unique_lock<std::mutex> guard(mutex);
+            return available.wait_for(guard, timeout, [&]() { return !pending.empty(); });
+        }
+
+        /**
+         * Returns the number of queued deliveries.
+         *
+         * @return Number of queued deliveries.
+         */
+        std::size_t size() const {
+            std::lock_guard<std::mutex> guard(mutex);
+            return pending.size();
+        }
+
+    private:
+
+        mutable std::mutex mutex;
+        std::condition_variable available;
+        std::vector<Task> pending;
+        std::vector<Task> running;
+    };
+
+    /**
+     * Executor that runs deliveries on a pool of worker threads.
+     *
+     * Each worker owns a serial lane and a delivery is posted to the lane its key hashes to, so
+     * deliveries with the same key run one at a time in the order they were posted while deliveries
+     * with different keys run in parallel. Lane storage is reused, so posting does not allocate once
+     * a lane has grown to its largest number of pending deliveries.
+     */
+    class ThreadPool final : public Executor {
+    public:
+
+        /**
+         * Starts the worker threads.
+         *
+         * @param threads Number of worker threads, one per hardware thread if 0.
+         */
+        explicit ThreadPool(unsigned threads = 0)
+                : lanes(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+            for (auto &lane : lanes) {
+                lane.worker = std::thread(&ThreadPool::run, std::ref(lane));
+            }
+        }
+
+        /**
+         * Runs the deliveries already queued then stops the worker threads.
+         */
+        ~ThreadPool() {
+            for (auto &lane : lanes) {
+                {
+                    std::lock_guard<std::mutex> guard(lane.mutex);
+                    lane.stopping = true;
+                }
+                lane.available.notify_one();
+            }
+            for (auto &lane : lanes) {
+                lane.worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        void post(Task task) override {
+            auto &lane = lanes[detail::mix(task.key()) % lanes.size()];
+            {
+                std::lock_guard<std::mutex> guard(lane.mutex);
+                lane.pending.push_back(std::move(task));
+            }
+            lane.available.notify_one();
+        }
+
+        /**
+         * Waits until every delivery queued so far has run.
+         */
+        void drain() {
+            for (auto &lane : lanes) {
+                std::unique_lock<std::mutex> guard(lane.mutex);
+                lane.idle.wait(guard, [&]() { return lane.pending.empty() && !lane.busy; });
+            }
+        }
+
+        /**
+         * Returns the number of worker threads.
+         *
+         * @return Number of worker threads.
+         */
+        std::size_t size() const {
+            return lanes.size();
+        }
+
+    private:
+
+        struct Lane {
+            std::mutex mutex;
+            std::condition_variable available;
+            std::condition_variable idle;
+            std::vector<Task> pending;
+            std::vector<Task> running;
+            bool busy = false;
+            bool stopping = false;
+            std::thread worker;
+        };
+
+        static void run(Lane &lane) {
+            std::unique_lock<std::mutex> guard(lane.mutex);
+            while (true) {
+                lane.available.wait(guard, [&]() { return lane.stopping || !lane.pending.empty(); });
+                if (lane.pending.empty()) {
+                    return;
+                }
+                std::swap(lane.pending, lane.running);
+                lane.busy = true;
+                guard.unlock();
+                for (auto &task : lane.running) {
+                    task();
+                }
+                lane.running.clear();
+                guard.lock();
+                lane.busy = false;
+                lane.idle.notify_all();
+            }
+        }
+
+    private:
+
+        std::vector<Lane> lanes;
+    };
+
+    /**
+     * Executor that runs the deliveries posted to it one at a time, in order, on another Executor.
+     *
+     * Binding all the Slots of an object to one Mailbox makes the object an actor: its Slot
+     * functions never run concurrently, whichever thread emitted, so they need no locks. Consecutive
+     * deliveries are run in batches of up to the batch size per scheduling on the other Executor,
+     * after which the Mailbox yields and schedules itself again.
+     *
+     * Slots bound to the Mailbox must be destroyed before it.
+     */
+    class Mailbox final : public Executor {
+    public:
+
+        /**
+         * Creates a Mailbox that runs on the provided Executor.
+         *
+         * @param executor Executor to run batches of deliveries on, such as a shared ThreadPool.
+         * @param batch Most deliveries to run per scheduling.
+         */
+        explicit Mailbox(Executor &executor, std::size_t batch = 64)
+                : state(std::make_shared<State>(executor, batch)) {}
+
+        Mailbox(const Mailbox &) = delete;
+
+        Mailbox &operator=(const Mailbox &) = delete;
+
+        void post(Task task) override {
+            bool schedule;
+            {
+                std::lock_guard<std::mutex> guard(state->mutex);
+                state->pending.push_back(std::move(task));
+                schedule = !state->scheduled;
+                state->scheduled = true;
+            }
+            if (schedule) {
+                State::schedule(state);
+            }
+        }
+
+        /**
+         * Returns the number of deliveries waiting for a batch.
+         *
+         * @return Number of queued deliveries.
+         */
+        std::size_t size() const {
+            std::lock_guard<std::mutex> guard(state->mutex);
+            return state->pending.size();
+        }
+
+    private:
+
+        struct State : std::enable_shared_from_this<State> {
+
+            State(Executor &executor, std::size_t batch)
+                    : executor(executor), batch(std::max<std::size_t>(batch, 1)) {}
+
+            static void schedule(const std::shared_ptr<State> &state) {
+                state->executor.post(Task(&State::run, state, nullptr, ++state->schedules));
+            }
+
+            static void run(void *target, detail::Envelope *) {
+                auto &state = *static_cast<State *>(target);
+                {
+                    std::lock_guard<std::mutex> guard(state.mutex);
+                    if (state.next == state.running.size()) {
+                        state.running.clear();
+                        state.next = 0;
+                        std::swap(state.pending, state.running);
+                    }
+                }
+                auto end = std::min(state.next + state.batch, state.running.size());
+                for (; state.next < end; state.next++) {
+                    Task task(std::move(state.running[state.next]));
+                    task();
+                }
+                bool again;
+                {
+                    std::lock_guard<std::mutex> guard(state.mutex);
+                    again = state.next < state.running.size() || !state.pending.empty();
+                    state.scheduled = again;
+                }
+                if (again) {
+                    schedule(state.shared_from_this());
+                }
+            }
+
+            Executor &executor;
+            std::size_t batch;
+            std::size_t schedules = 0;
+            std::mutex mutex;
+            std::vector<Task> pending;
+            std::vector<Task> running;
+            std::size_t next = 0;
+            bool scheduled = false;
+        };
+
+        std::shared_ptr<State> state;
+    };
+
+    /**
+     * Lock that does nothing, for Signals and Slots that are only used from a single thread.
+     */
+    struct NullLock {
+        void lock() {}
+
+        void unlock() {}
+
+        bool try_lock() { return true; }
+    };
+
+    /**
+     * Lock that busy waits, for short critical sections with little contention.
+     */
+    class SpinLock {
+    public:
+
+        void lock() {
+            while (flag.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+
+        void unlock() {
+            flag.clear(std::memory_order_release);
+        }
+
+        bool try_lock() {
+            return !flag.test_and_set(std::memory_order_acquire);
+        }
+
+    private:
+
+        std::atomic_flag flag = ATOMIC_FLAG_INIT;
+    };
+
+    /**
+     * Locking policy for Signals and Slots that are only used from a single thread.
+     */
+    struct NoLocking {
+        using Lock = NullLock;
+    };
+
+    /**
+     * Locking policy that protects each Signal and Slot with a SpinLock.
+     */
+    struct SpinLocking {
+        using Lock = SpinLock;
+    };
+
+    /**
+     * Locking policy that protects each Signal and Slot with a std::mutex.
+     *
+     * A Signal stays locked while it calls its Slots, and neither lock is recursive, so with this
+     * policy or SpinLocking a Slot function must not emit, connect or disconnect the Signal
+     * calling it. That includes a one-shot Slot re-arming itself with connectOnce() and a Slot
+     * called by a frame flush, which deadlock instead.
+     */
+    struct MutexLocking {
+        using Lock = std::mutex;
+    };
+
+    /**
+     * Storage policy that keeps connections in a std::vector.
+     */
+    struct VectorStorage {
+        template<typename T>
+        using Container = detail::ConnectionList<T>;
+    };
+
+    /**
+     * Storage policy that keeps up to N connections inside the Signal or Slot before allocating.
+     */
+    template<std::size_t N>
+    struct SmallVectorStorage {
+        template<typename T>
+        using Container = detail::SmallVector<T, N>;
+    };
+
+    /**
+     * Ordering policy that calls Slots in the order they were connected.
+     */
+    struct InsertionOrder {
+
+        static constexpr bool prioritized = false;
+
+        template<typename Slot>
+        struct Connection {
+            const Slot *slot;
+        };
+
+        template<typename Slot>
+        static Connection<Slot> connection(const Slot &slot, int) {
+            return {&slot};
+        }
+
+        template<typename Slot>
+        static int priority(const Connection<Slot> &) {
+            return 0;
+        }
+
+        template<typename Container, typename Slot>
+        static void insert(Container &connections, const Connection<Slot> &connection) {
+            connections.push_back(connection);
+        }
+    };
+
+    /**
+     * Ordering policy that calls Slots with a higher priority first, and Slots of equal priority in
+     * the order they were connected.
+     */
+    struct PriorityOrder {
+
+        static constexpr bool prioritized = true;
+
+        template<typename Slot>
+        struct Connection {
+            const Slot *slot;
+            int priority;
+        };
+
+        template<typename Slot>
+        static Connection<Slot> connection(const Slot &slot, int priority) {
+            return {&slot, priority};
+        }
+
+        template<typename Slot>
+        static int priority(const Connection<Slot> &connection) {
+            return connection.priority;
+        }
+
+        template<typename Container, typename Slot>
+        static void insert(Container &connections, const Connection<Slot> &connection) {
+            auto position = std::find_if(connections.begin(), connections.end(), [&](const Connection<Slot> &c) {
+                return c.priority < connection.priority;
+            });
+            connections.insert(position, connection);
+        }
+    };
+
+    /**
+     * Compile time configuration of a BasicSignal and BasicSlot.
+     *
+     * @tparam Locking Locking policy: NoLocking, SpinLocking or MutexLocking.
+     * @tparam Storage Storage policy: VectorStorage or SmallVectorStorage<N>.
+     * @tparam Ordering Ordering policy: InsertionOrder or PriorityOrder.
+     */
+    template<typename Locking = NoLocking, typename Storage = VectorStorage, typename Ordering = InsertionOrder>
+    struct Policy {
+
+        using Lock = typename Locking::Lock;
+
+        template<typename T>
+        using Container = typename Storage::template Container<T>;
+
+        using Order = Ordering;
+    };
+
+    using DefaultPolicy = Policy<>;
+
+    /**
+     * How a Signal delivers each emission.
+     */
+    enum class Delivery {
+        /**
+         * Every connected Slot is called.
+         */
+        Broadcast,
+        /**
+         * One connected Slot is called, each in turn.
+         */
+        RoundRobin,
+        /**
+         * The connected Slot with the fewest pending queued deliveries is called.
+         */
+        LeastLoaded,
+        /**
+         * The connected Slot with fewer pending queued deliveries out of two chosen at random is
+         * called.
+         */
+        RandomOfTwo,
+        /**
+         * The connected Slot that owns the key of the emission on a consistent hash ring is called,
+         * so that emissions with the same key go to the same Slot.
+         */
+        ConsistentHash
+    };
+
+    namespace detail {
+
+        /**
+         * Consistent hash ring with virtual nodes. Each Slot owns the keys that hash between its
+         * points and the previous point on the ring, so connecting or disconnecting a Slot only moves
+         * the keys of the ranges next to its own points.
+         */
+        template<typename Slot, typename Key>
+        struct HashRing {
+
+            using Point = std::pair<std::uint64_t, const Slot *>;
+
+            HashRing(Key key, int virtualNodes)
+                    : key(std::move(key)), virtualNodes(std::max(virtualNodes, 1)) {}
+
+            void add(const Slot *slot) {
+                for (int i = 0; i < virtualNodes; i++) {
+                    Point point(mix(reinterpret_cast<std::uintptr_t>(slot) ^ mix(i)), slot);
+                    points.insert(std::upper_bound(points.begin(), points.end(), point), point);
+                }
+            }
+
+            void remove(const Slot *slot) {
+                points.erase(std::remove_if(points.begin(), points.end(), [&](const Point &point) {
+                    return point.second == slot;
+                }), points.end());
+            }
+
+            const Slot *find(std::size_t value) const {
+                auto hash = mix(value);
+                auto point = std::lower_bound(points.begin(), points.end(), hash, [](const Point &p, std::uint64_t h) {
+                    return p.first < h;
+                });
+                return point == points.end() ? points.front().second : point->second;
+            }
+
+            Key key;
+            int virtualNodes;
+            std::vector<Point> points;
+        };
+    }
+
+    /**
+     * Returned by a Slot function to continue or stop the propagation of an emitUntilStopped().
+     */
+    enum class Propagation {
+        Continue,
+        Stop
+    };
+
+    namespace detail {
+
+        inline bool &propagationStopped() {
+            static thread_local bool stopped = false;
+            return stopped;
+        }
+
+        /**
+         * Slot function returning Propagation, which reports a Stop to the emitting Signal.
+         */
+        template<typename F>
+        struct PropagationHandler {
+
+            template<typename... Ts>
+            void operator()(Ts &&... args) const {
+                propagationStopped() = function(std::forward<Ts>(args)...) == Propagation::Stop;
+            }
+
+            F function;
+        };
+
+        /**
+         * Restores the propagation flag on destruction, so that Slots called by a nested emit do
+         * not report a Stop to an enclosing emitUntilStopped().
+         */
+        struct PropagationScope {
+
+            PropagationScope() : outer(propagationStopped()) {}
+
+            ~PropagationScope() {
+                propagationStopped() = outer;
+            }
+
+            PropagationScope(const PropagationScope &) = delete;
+
+            PropagationScope &operator=(const PropagationScope &) = delete;
+
+            bool outer;
+        };
+    }
+
+    /**
+     * How a Signal coalesces the emissions recorded during a Transaction.
+     */
+    enum class Coalesce {
+        /**
+         * Every recorded emission is delivered.
+         */
+        KeepAll,
+        /**
+         * Only the last recorded emission is delivered.
+         */
+        KeepLast,
+        /**
+         * Recorded emissions are merged into one by the Signal's merge function.
+         */
+        Merge
+    };
+
+    namespace detail {
+
+        /**
+         * Recorded call, flushed by calling flush with the Signal or Property that recorded it.
+         */
+        struct Recorded {
+            void (*flush)(void *);
+            void *target;
+        };
+
+        /**
+         * Calls recorded on a thread while a Transaction or PropertyUpdate is open, flushed in
+         * order when the outermost one ends.
+         */
+        struct Deferral {
+
+            /**
+             * Ends a scope and, if it is the outermost one, flushes the recorded calls, including
+             * those recorded while flushing. If a call throws, the calls not yet flushed stay
+             * recorded until the next outermost scope ends.
+             *
+             * @param depth Number of scopes open on this thread.
+             */
+            void close(int &depth) {
+                if (--depth != 0 || flushing) {
+                    return;
+                }
+                flushing = true;
+                struct Flush {
+                    ~Flush() {
+                        deferral.recorded.erase(deferral.recorded.begin(), deferral.recorded.begin() + flushed);
+                        deferral.flushing = false;
+                    }
+                    Deferral &deferral;
+                    std::size_t flushed;
+                } flush{*this, 0};
+                while (flush.flushed < recorded.size()) {
+                    auto call = recorded[flush.flushed++];
+                    if (call.target != nullptr) {
+                        call.flush(call.target);
+                    }
+                }
+            }
+
+            /**
+             * Drops the calls recorded for a target that is being destroyed.
+             */
+            void forget(const void *target) {
+                for (auto &call : recorded) {
+                    if (call.target == target) {
+                        call.target = nullptr;
+                    }
+                }
+            }
+
+            bool flushing = false;
+            std::vector<Recorded> recorded;
+        };
+
+        inline int &transactionDepth() {
+            static thread_local int depth = 0;
+            return depth;
+        }
+
+        inline Deferral &transactions() {
+            static thread_local Deferral transactions;
+            return transactions;
+        }
+
+        inline int &propertyUpdateDepth() {
+            static thread_local int depth = 0;
+            return depth;
+        }
+
+        inline Deferral &propertyUpdates() {
+            static thread_local Deferral updates;
+            return updates;
+        }
+    }
+
+    /**
+     * Records the emissions of Signals on this thread instead of delivering them, then delivers
+     * them in order when it commits, coalesced as set on each Signal.
+     *
+     * A coalesced Signal is delivered at the position of its first recorded emission. Transactions
+     * may be nested, only the outermost one delivers. A Signal must only be recorded by one thread's
+     * Transaction at a time.
+     */
+    class Transaction final {
+    public:
+
+        Transaction() {
+            ++detail::transactionDepth();
+        }
+
+        /**
+         * Commits the transaction unless already committed. A Slot throwing from this commit calls
+         * std::terminate, so commit() explicitly where Slots may throw.
+         */
+        ~Transaction() {
+            commit();
+        }
+
+        Transaction(const Transaction &) = delete;
+
+        Transaction &operator=(const Transaction &) = delete;
+
+        /**
+         * Ends the transaction and, if it is the outermost one, delivers the recorded emissions. If
+         * a Slot throws, the emissions not yet delivered stay recorded for the next outermost commit
+         * on this thread.
+         */
+        void commit() {
+            if (committed) {
+                return;
+            }
+            committed = true;
+            detail::transactions().close(detail::transactionDepth());
+        }
+
+    private:
+
+        bool committed = false;
+    };
+
+    /**
+     * Collects the emissions of the Signals attached to it during a frame and delivers them at a
+     * sync point, e.g. once per iteration of a game or UI loop.
+     *
+     * Each attached Signal keeps the emissions of the frame in its own buffer. dispatch() delivers
+     * them Signal by Signal, in the order each Signal first emitted during the frame, calling each
+     * connected Slot for all of the Signal's emissions in turn rather than every Slot per emission.
+     * Buffers keep their capacity between frames, so resetting them costs nothing for trivially
+     * destructible arguments. Slots bound to an Executor share one envelope per emission, copied
+     * once for all of them rather than once per Slot.
+     *
+     * Signals must be detached or destroyed before the dispatcher, and not while it dispatches.
+     */
+    class FrameDispatcher final {
+    public:
+
+        FrameDispatcher() = default;
+
+        FrameDispatcher(const FrameDispatcher &) = delete;
+
+        FrameDispatcher &operator=(const FrameDispatcher &) = delete;
+
+        /**
+         * Delivers the emissions collected since the last dispatch. Emissions made by the Slots
+         * called are delivered by the next dispatch.
+         *
+         * @return Number of Signals delivered.
+         */
+        std::size_t dispatch() {
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                std::swap(pending, dispatching);
+            }
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < dispatching.size(); i++) {
+                auto recorded = dispatching[i];
+                if (recorded.target != nullptr) {
+                    recorded.flush(recorded.target);
+                    ++count;
+                }
+            }
+            std::lock_guard<std::mutex> guard(mutex);
+            dispatching.clear();
+            return count;
+        }
+
+        /**
+         * Returns the number of Signals that emitted since the last dispatch.
+         *
+         * @return Number of Signals waiting for dispatch.
+         */
+        std::size_t size() const {
+            std::lock_guard<std::mutex> guard(mutex);
+            return pending.size();
+        }
+
+        /**
+         * Adds a Signal that emitted for the first time this frame.
+         */
+        void add(void (*flush)(void *), void *signal) {
+            std::lock_guard<std::mutex> guard(mutex);
+            pending.push_back({flush, signal});
+        }
+
+        /**
+         * Removes a Signal that is being detached or destroyed.
+         */
+        void remove(void *signal) {
+            std::lock_guard<std::mutex> guard(mutex);
+            for (auto *list : {&pending, &dispatching}) {
+                for (auto &recorded : *list) {
+                    if (recorded.target == signal) {
+                        recorded.target = nullptr;
+                    }
+                }
+            }
+        }
+
+    private:
+
+        mutable std::mutex mutex;
+        std::vector<detail::Recorded> pending;
+        std::vector<detail::Recorded> dispatching;
+    };
+
+    namespace detail {
+
+        /**
+         * Emissions of a Signal recorded during a Transaction, held while it is paused or collected
+         * for a FrameDispatcher.
+         */
+        template<typename... Args>
+        struct Recording {
+
+            using Arguments = std::tuple<Owned<Args>...>;
+
+            Coalesce coalesce = Coalesce::KeepAll;
+            std::function<void(Arguments &, Parameter<Args>...)> merge;
+            std::vector<Arguments> pending;
+            std::size_t next = 0;
+            bool paused = false;
+            std::vector<Arguments> held;
+            FrameDispatcher *dispatcher = nullptr;
+            std::vector<Arguments> framed;
+            std::vector<Arguments> delivering;
+            std::vector<EmissionEnvelope<Args...>> envelopes;
+        };
+
+        /**
+         * Sampling, rate limit and remaining deliveries of one connection, evaluated before the Slot
+         * is called. A Signal keeps its filters at the index of their connection.
+         */
+        struct DeliveryFilter {
+
+            using Clock = std::chrono::steady_clock;
+
+            bool admit() {
+                if (expired) {
+                    return false;
+                }
+                if (every > 1 && sampled++ % every != 0) {
+                    ++suppressed;
+                    return false;
+                }
+                if (rate > 0) {
+                    auto now = Clock::now();
+                    tokens = std::min(burst, tokens + std::chrono::duration<double>(now - last).count() * rate);
+                    last = now;
+                    if (tokens < 1) {
+                        ++suppressed;
+                        return false;
+                    }
+                    tokens -= 1;
+                }
+                if (shots != 0 && --shots == 0) {
+                    expired = true;
+                }
+                return true;
+            }
+
+            std::uint64_t every = 1;
+            std::uint64_t sampled = 0;
+            double rate = 0;
+            double burst = 0;
+            double tokens = 0;
+            Clock::time_point last;
+            std::size_t suppressed = 0;
+            std::uint64_t shots = 0;
+            bool expired = false;
+        };
+    }
+
+    template<typename P, typename... Args>
+    class BasicSignal;
+
+    template<typename P, typename... Args>
+    class BasicSlot final {
+
+        friend class BasicSignal<P, Args...>;
+
+        using SignalType = BasicSignal<P, Args...>;
+        using Lock = typename P::Lock;
+        using Guard = std::lock_guard<Lock>;
+        using Receiver = detail::Receiver<BasicSlot>;
+
+    public:
+
+        using Function = std::function<void(Parameter<Args>...)>;
+
+        using Key = std::function<std::size_t(Parameter<Args>...)>;
+
+    private:
+
+        /**
+         * Receiver of a Slot bound to an Executor. The Executor and ordering key live here rather
+         * than in the Slot, so that Slots called directly by emit do not store them.
+         */
+        struct Binding : Receiver {
+
+            Binding(const BasicSlot *slot, Executor *executor, Key key)
+                    : Receiver(slot), executor(executor), key(std::move(key)) {}
+
+            Executor *const executor;
+            const Key key;
+        };
+
+    public:
+
+        BasicSlot() = default;
+
+        explicit BasicSlot(Function callback)
+                : callback(std::move(callback)) {}
+
+        template<typename F, typename = typename std::enable_if<
+                !std::is_same<typename std::decay<F>::type, BasicSlot>::value &&
+                !std::is_same<typename std::decay<F>::type, Function>::value>::type>
+        explicit BasicSlot(F &&function)
+                : callback(handler(std::forward<F>(function))) {
+            setCallbackBytes(detail::callbackHeapBytes<decltype(handler(std::forward<F>(function)))>(callback));
+        }
+
+        template<typename T>
+        BasicSlot(T *instance, void (T::*function)(Args...))
+                : BasicSlot([=](Parameter<Args>... args) {
+                    (instance->*function)(std::forward<Parameter<Args>>(args)...);
+                }) {}
+
+        /**
+         * Creates a Slot whose function is called by the provided Executor rather than by emit.
+         *
+         * Emitted arguments are copied once per emission into a reference counted envelope that is
+         * shared by every queued Slot, and rvalue reference arguments are copied again for each Slot
+         * so that it can move from its own. Deliveries still queued when the Slot is destroyed are
+         * dropped.
+         *
+         * Moving or destroying the Slot waits for deliveries already running on other threads, so
+         * the function must not move or destroy its own Slot.
+         *
+         * @param executor Executor to queue deliveries on.
+         * @param function Function to call for each delivery.
+         */
+        template<typename F>
+        BasicSlot(Executor &executor, F &&function)
+                : BasicSlot(std::forward<F>(function)) {
+            bind(&executor);
+        }
+
+        /**
+         * Creates a Slot whose function is called by the provided Executor, with each delivery
+         * ordered by a key extracted from the emitted arguments.
+         *
+         * A ThreadPool runs deliveries with the same key in the order they were emitted and
+         * deliveries with different keys in parallel. Without a key every delivery to the Slot has
+         * the same key.
+         *
+         * @param executor Executor to queue deliveries on.
+         * @param key Function returning the ordering key of an emission.
+         * @param function Function to call for each delivery.
+         */
+        template<typename F>
+        BasicSlot(Executor &executor, Key key, F &&function)
+                : BasicSlot(std::forward<F>(function)) {
+            bind(&executor, std::move(key));
+        }
+
+        ~BasicSlot() {
+            disconnectAll();
+            bind(nullptr);
+            setCallbackBytes(0);
+        }
+
+        /**
+         * Copies all connections of other Slot to this Slot. The function is copied before the
+         * connections, so a Signal emitting on another thread never calls the copy without it.
+         * @param other Slot to copy connections from.
+         */
+        BasicSlot(const BasicSlot &other) {
+            this->callback = other.callback;
+            setCallbackBytes(other.callbackBytes);
+            bindLike(other);
+            copyConnectionsFrom(other);
+        }
+
+        /**
+         * Replaces connections of this Slot with connections of other Slot.
+         * @param other Slot to copy connections from.
+         * @return Copy assigned instance.
+         */
+        BasicSlot &operator=(const BasicSlot &other) {
+            if (this != &other) {
+                disconnectAll();
+                this->callback = other.callback;
+                setCallbackBytes(other.callbackBytes);
+                bindLike(other);
+                copyConnectionsFrom(other);
+            }
+            return *this;
+        };
+
+        /**
+         * Copies all connections of other Slot to this Slot then disconnects other Slot. The
+         * function of other is moved first, so Signals connected to other must not emit on another
+         * thread during the move.
+         * @param other Slot to copy connections from.
+         */
+        BasicSlot(BasicSlot &&other) noexcept {
+            swapWith(other);
+            copyConnectionsFrom(other);
+            other.disconnectAll();
+        }
+
+        /**
+         * Replaces connections of this Slot with connections of other Slot then disconnects other
+         * Slot.
+         * @param other Slot to copy connections from.
+         * @return Move assigned instance.
+         */
+        BasicSlot &operator=(BasicSlot &&other) noexcept {
+            if (this != &other) {
+                disconnectAll();
+                swapWith(other);
+                copyConnectionsFrom(other);
+                other.disconnectAll();
+            }
+            return *this;
+        }
+
+        /**
+         * Returns the number of connections for this Slot.
+         *
+         * @return Number of connections for this Slot.
+         */
+        int connectionCount() const {
+            Guard guard(lock);
+            return signals.size();
+        }
+
+        /**
+         * Returns true if this Slot is connected to the provided Signal.
+         *
+         * @param signal Signal to test connection against.
+         * @return true if connected.
+         */
+        bool isConnectedTo(const SignalType &signal) const {
+            Guard guard(lock);
+            return std::find(signals.begin(), signals.end(), &signal) != signals.end();
+        }
+
+        /**
+         * Returns the number of deliveries queued for this Slot that have not yet completed. Always 0
+         * for a Slot that is not bound to an Executor.
+         *
+         * @return Number of pending deliveries.
+         */
+        std::size_t pendingCount() const {
+            return receiver ? receiver->pending.load(std::memory_order_relaxed) : 0;
+        }
+
+        /**
+         * Returns the memory held by the connections and callback of this Slot.
+         *
+         * Callback bytes are only known for callables passed directly to the Slot, a callback passed
+         * as a std::function is reported as 0.
+         *
+         * @return Memory usage of this Slot.
+         */
+        MemoryUsage memoryUsage() const {
+            Guard guard(lock);
+            MemoryUsage usage = detail::connectionListUsage(signals);
+            usage.callbackBytes = callbackBytes;
+            usage.stateBytes = receiver ? sizeof(Binding) : 0;
+            return usage;
+        }
+
+        /**
+         * Releases unused capacity of the connection list of this Slot.
+         */
+        void shrinkToFit() const {
+            Guard guard(lock);
+            signals.shrink_to_fit();
+        }
+
+        /**
+         * Reserves capacity for the provided number of connections so that connecting does not
+         * allocate until it is exceeded.
+         *
+         * @param count Number of connections to reserve capacity for.
+         */
+        void reserve(int count) const {
+            Guard guard(lock);
+            signals.reserve(count);
+        }
+
+    private:
+
+        template<typename F>
+        using StopsPropagation = std::is_same<
+                typename std::result_of<typename std::decay<F>::type &(Parameter<Args>...)>::type, Propagation>;
+
+        template<typename F>
+        static typename std::enable_if<!StopsPropagation<F>::value, typename std::decay<F>::type>::type
+        handler(F &&function) {
+            return std::forward<F>(function);
+        }
+
+        template<typename F>
+        static typename std::enable_if<StopsPropagation<F>::value, detail::PropagationHandler<typename std::decay<F>::type>>::type
+        handler(F &&function) {
+            return {std::forward<F>(function)};
+        }
+
+        void addSignal(SignalType &signal) const {
+            signals.push_back(&signal);
+        }
+
+        void removeSignal(SignalType &signal) const {
+            signals.erase(std::remove(signals.begin(), signals.end(), &signal), signals.end());
+        }
+
+        void disconnectAll() {
+            std::unique_lock<Lock> guard(lock);
+            while (!signals.empty()) {
+                auto *signal = signals.back();
+                if (!signal->lock.try_lock()) {
+                    guard.unlock();
+                    std::this_thread::yield();
+                    guard.lock();
+                    continue;
+                }
+                signal->removeSlot(*this);
+                signals.pop_back();
+                signal->lock.unlock();
+            }
+        }
+
+        /**
+         * Reads each connection of other under its lock but connects without it, so that copying
+         * a Slot and its Signal on two threads can not lock them in opposite order.
+         */
+        void copyConnectionsFrom(const BasicSlot &other) {
+            for (std::size_t i = 0;; i++) {
+                SignalType *signal = nullptr;
+                {
+                    Guard guard(other.lock);
+                    if (i >= other.signals.size()) {
+                        return;
+                    }
+                    signal = other.signals[i];
+                }
+                signal->connectLike(*this, other);
+            }
+        }
+
+        void bind(Executor *executor, Key key = Key()) {
+            if (receiver) {
+                receiver->pause();
+                receiver->resume(nullptr);
+            }
+            receiver.reset();
+            if (executor != nullptr) {
+                receiver = std::make_shared<Binding>(this, executor, std::move(key));
+            }
+        }
+
+        void bindLike(const BasicSlot &other) {
+            if (other.receiver) {
+                bind(other.receiver->executor, other.receiver->key);
+            } else {
+                bind(nullptr);
+            }
+        }
+
+        /**
+         * Swaps the function and binding of this Slot with other Slot, with the queued deliveries
+         * of both paused so that none runs a function while it is being swapped. A move swaps
+         * before connecting this Slot, so that a Signal never calls it without its function.
+         */
+        void swapWith(BasicSlot &other) {
+            pauseReceiver();
+            other.pauseReceiver();
+            std::swap(callback, other.callback);
+            std::swap(callbackBytes, other.callbackBytes);
+            std::swap(receiver, other.receiver);
+            resumeReceiver();
+            other.resumeReceiver();
+        }
+
+        void pauseReceiver() {
+            if (receiver) {
+                receiver->pause();
+            }
+        }
+
+        void resumeReceiver() {
+            if (receiver) {
+                receiver->resume(this);
+            }
+        }
+
+        void post(detail::Envelope *envelope) const {
+            envelope->retain();
+            receiver->pending.fetch_add(1, std::memory_order_relaxed);
+            std::size_t hash = reinterpret_cast<std::uintptr_t>(receiver.get());
+            if (receiver->key) {
+                auto &arguments = static_cast<detail::ArgumentEnvelope<Args...> *>(envelope)->arguments();
+                hash = detail::applyShared<Args...>(receiver->key, arguments, std::index_sequence_for<Args...>());
+            }
+            receiver->executor->post(Task(&BasicSlot::deliver, receiver, envelope, hash));
+        }
+
+        static void deliver(void *target, detail::Envelope *envelope) {
+            Receiver *receiver = static_cast<Binding *>(target);
+            auto &arguments = static_cast<detail::ArgumentEnvelope<Args...> *>(envelope)->arguments();
+            if (auto *slot = receiver->enter()) {
+                struct Leave {
+                    ~Leave() {
+                        detail::runningReceiver() = outer;
+                        receiver->leave();
+                    }
+                    Receiver *receiver;
+                    const void *outer;
+                } leave{receiver, detail::runningReceiver()};
+                detail::runningReceiver() = receiver;
+                detail::applyShared<Args...>(slot->callback, arguments, std::index_sequence_for<Args...>());
+            }
+            receiver->pending.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void setCallbackBytes(std::size_t bytes) {
+            auto &counter = detail::memoryCounters().callbackBytes;
+            counter.fetch_add(bytes, std::memory_order_relaxed);
+            counter.fetch_sub(callbackBytes, std::memory_order_relaxed);
+            callbackBytes = bytes;
+        }
+
+    private:
+
+        Function callback;
+
+        std::size_t callbackBytes = 0;
+
+        std::shared_ptr<Binding> receiver;
+
+        mutable Lock lock;
+
+        mutable typename P::template Container<SignalType *> signals;
+
+    };
+
+    template<typename P, typename... Args>
+    class BasicSignal final {
+
+        friend class BasicSlot<P, Args...>;
+
+        using SlotType = BasicSlot<P, Args...>;
+        using Lock = typename P::Lock;
+        using Guard = std::lock_guard<Lock>;
+        using Order = typename P::Order;
+        using Connection = typename Order::template Connection<SlotType>;
+        using Ring = detail::HashRing<SlotType, std::function<std::size_t(Parameter<Args>...)>>;
+        using Recording = detail::Recording<Args...>;
+
+        /**
+         * State of the delivery modes, recording and delivery filters, allocated when first used so
+         * that a Signal using none of them holds only its connections.
+         */
+        struct Extension {
+            Delivery mode = Delivery::Broadcast;
+            std::uint32_t seed = 2463534242u;
+            std::size_t cursor = 0;
+            std::unique_ptr<Ring> ring;
+            Recording recording;
+            BasicSignal *parent = nullptr;
+            std::vector<detail::DeliveryFilter> filters;
+            std::size_t expired = 0;
+
+            std::size_t bytes() const {
+                auto buffered = recording.pending.capacity() + recording.held.capacity() +
+                                recording.framed.capacity() + recording.delivering.capacity();
+                return sizeof(Extension) + (ring ? sizeof(Ring) + ring->points.capacity() * sizeof(ring->points[0]) : 0) +
+                       buffered * sizeof(Arguments) +
+                       recording.envelopes.capacity() * sizeof(detail::EmissionEnvelope<Args...>) +
+                       filters.capacity() * sizeof(detail::DeliveryFilter);
+            }
+
+            void shrinkToFit() {
+                if (ring) {
+                    ring->points.shrink_to_fit();
+                }
+                recording.pending.shrink_to_fit();
+                recording.held.shrink_to_fit();
+                recording.framed.shrink_to_fit();
+                recording.delivering.shrink_to_fit();
+                recording.envelopes.shrink_to_fit();
+                filters.shrink_to_fit();
+            }
+        };
+
+    public:
+
+        using Arguments = typename Recording::Arguments;
+
+        BasicSignal() = default;
+
+        ~BasicSignal() {
+            disconnectAll();
+            forgetRecorded();
+        }
+
+        /**
+         * Copies all connections of other Signal to this Signal.
+         * @param other Signal to copy connections from.
+         */
+        BasicSignal(const BasicSignal &other) {
+            copyConnectionsFrom(other);
+            copyDeliveryFrom(other);
+        }
+
+        /**
+         * Replaces connections of this Signal with connections of other Signal.
+         * @param other Signal to copy connections from.
+         * @return Copy assigned instance.
+         */
+        BasicSignal &operator=(const BasicSignal &other) {
+            if (this != &other) {
+                disconnectAll();
+                copyConnectionsFrom(other);
+                copyDeliveryFrom(other);
+            }
+            return *this;
+        };
+
+        /**
+         * Copies all connections of other Signal to this Signal then disconnects other Signal. If
+         * other is paused, this Signal is paused instead and takes the emissions it buffered.
+         * @param other Signal to copy connections from.
+         */
+        BasicSignal(BasicSignal &&other) noexcept {
+            copyConnectionsFrom(other);
+            other.disconnectAll();
+            copyDeliveryFrom(other);
+            takeHeldFrom(other);
+        }
+
+        /**
+         * Replaces connections of this Signal with connections of other Signal then disconnects other
+         * Signal. The paused state and buffered emissions of this Signal are replaced with those of
+         * other.
+         * @param other Signal to copy connections from.
+         * @return Move assigned instance.
+         */
+        BasicSignal &operator=(BasicSignal &&other) noexcept {
+            if (this != &other) {
+                disconnectAll();
+                copyConnectionsFrom(other);
+                other.disconnectAll();
+                copyDeliveryFrom(other);
+                takeHeldFrom(other);
+            }
+            return *this;
+        }
+
+        /**
+         * Calls function(s) of the connected Slot(s), or queues them on the Executor of Slots bound
+         * to one. Which Slots are called depends on the delivery mode. While paused the emission
+         * is buffered instead.
+         *
+         * The Signal is locked while the Slot functions are called, so with a locking policy they
+         * must not emit, connect or disconnect this Signal.
+         *
+         * @param args Arguments to pass to the Slot functions.
+         */
+        void emit(Parameter<Args>... args) {
+            if (detail::transactionDepth() != 0) {
+                record(std::forward<Parameter<Args>>(args)...);
+                return;
+            }
+            Guard guard(lock);
+            if (extension && extension->recording.paused) {
+                append(extension->recording.held, 0, std::forward<Parameter<Args>>(args)...);
+                return;
+            }
+            if (extension && extension->recording.dispatcher) {
+                auto &state = extension->recording;
+                auto first = state.framed.empty();
+                append(state.framed, 0, std::forward<Parameter<Args>>(args)...);
+                if (first) {
+                    state.dispatcher->add(&BasicSignal::flushFrame, this);
+                }
+                return;
+            }
+            deliverAll(std::forward<Parameter<Args>>(args)...);
+        }
+
+        /**
+         * Attaches this Signal to a FrameDispatcher, so that its emissions are collected and
+         * delivered by the next dispatch. Emissions are coalesced as set by setCoalescing().
+         *
+         * @param dispatcher Dispatcher to attach to, or nullptr to detach and deliver immediately
+         * again. Emissions already collected are delivered when detaching.
+         */
+        void setDispatcher(FrameDispatcher *dispatcher) {
+            {
+                Guard guard(lock);
+                auto &state = recordingState();
+                if (state.dispatcher == dispatcher) {
+                    return;
+                }
+                if (state.dispatcher != nullptr && !state.framed.empty()) {
+                    state.dispatcher->remove(this);
+                    if (dispatcher != nullptr) {
+                        dispatcher->add(&BasicSignal::flushFrame, this);
+                    }
+                }
+                state.dispatcher = dispatcher;
+            }
+            if (dispatcher == nullptr) {
+                flushFrame(this);
+            }
+        }
+
+        /**
+         * Buffers emissions instead of delivering them until resume(), keeping all connections.
+         *
+         * Buffered emissions are coalesced as set by setCoalescing(). The buffer keeps its capacity,
+         * so pausing again does not allocate until it is exceeded.
+         */
+        void pause() {
+            Guard guard(lock);
+            recordingState().paused = true;
+        }
+
+        /**
+         * Delivers the emissions buffered since pause(), in order, as one batch, then delivers
+         * further emissions immediately.
+         */
+        void resume() {
+            Guard guard(lock);
+            if (!extension || !extension->recording.paused) {
+                return;
+            }
+            extension->recording.paused = false;
+            auto &held = extension->recording.held;
+            for (std::size_t i = 0; i < held.size(); i++) {
+                Arguments arguments(std::move(held[i]));
+                detail::apply<Args...>([&](Parameter<Args>... args) {
+                    deliverAll(std::forward<Parameter<Args>>(args)...);
+                }, arguments, std::index_sequence_for<Args...>());
+            }
+            held.clear();
+        }
+
+        /**
+         * @return true if emissions are buffered until resume().
+         */
+        bool isPaused() const {
+            Guard guard(lock);
+            return extension && extension->recording.paused;
+        }
+
+        /**
+         * Returns the number of emissions buffered since pause().
+         *
+         * @return Number of buffered emissions.
+         */
+        std::size_t bufferedCount() const {
+            Guard guard(lock);
+            return extension ? extension->recording.held.size() : 0;
+        }
+
+        /**
+         * Calls the function of each connected Slot in order until one returns Propagation::Stop,
+         * then, unless stopped, does the same for the parent Signal and its parents in turn.
+         *
+         * Only Slots called directly can stop propagation, Slots bound to an Executor are queued and
+         * propagation continues. Emissions are delivered immediately, even during a Transaction or
+         * while paused, and regardless of the delivery mode.
+         *
+         * @param args Arguments to pass to the Slot functions.
+         * @return true if a Slot stopped propagation.
+         */
+        bool emitUntilStopped(Parameter<Args>... args) {
+            detail::PropagationScope scope;
+            auto &stopped = detail::propagationStopped();
+            stopped = false;
+            auto *signal = this;
+            while (signal != nullptr && !stopped) {
+                signal = signal->deliverUntilStopped(std::forward<Parameter<Args>>(args)...);
+            }
+            return stopped;
+        }
+
+        /**
+         * Sets the Signal that emitUntilStopped() bubbles up to when no Slot of this Signal stops
+         * propagation.
+         *
+         * @param parent Parent Signal, which must outlive this Signal, or nullptr for none.
+         */
+        void setParent(BasicSignal *parent) {
+            Guard guard(lock);
+            extended().parent = parent;
+        }
+
+        /**
+         * Delivers only the first of every n emissions to the provided Slot, the others are
+         * suppressed before its function is called.
+         *
+         * @param slot Connected Slot to sample deliveries to.
+         * @param every Number of emissions per delivery, 1 to deliver every emission.
+         */
+        void setSampling(const SlotType &slot, std::uint64_t every) {
+            Guard guard(lock);
+            if (auto *filter = filterFor(slot)) {
+                filter->every = std::max<std::uint64_t>(every, 1);
+                filter->sampled = 0;
+            }
+        }
+
+        /**
+         * Limits deliveries to the provided Slot with a token bucket, further emissions are
+         * suppressed before its function is called.
+         *
+         * @param slot Connected Slot to limit deliveries to.
+         * @param perSecond Deliveries allowed per second on average, 0 for no limit.
+         * @param burst Deliveries allowed at once after a quiet period.
+         */
+        void setRateLimit(const SlotType &slot, double perSecond, double burst = 1) {
+            Guard guard(lock);
+            if (auto *filter = filterFor(slot)) {
+                filter->rate = perSecond;
+                filter->burst = std::max(burst, 1.0);
+                filter->tokens = filter->burst;
+                filter->last = detail::DeliveryFilter::Clock::now();
+            }
+        }
+
+        /**
+         * Returns the number of deliveries to the provided Slot suppressed by its sampling or rate
+         * limit.
+         *
+         * @param slot Slot to count suppressed deliveries of.
+         * @return Number of suppressed deliveries.
+         */
+        std::size_t suppressedCount(const SlotType &slot) const {
+            Guard guard(lock);
+            auto connection = find(slot);
+            if (!extension || extension->filters.empty() || connection == slots.end()) {
+                return 0;
+            }
+            return extension->filters[connection - slots.begin()].suppressed;
+        }
+
+        /**
+         * Sets how each emission is delivered. Broadcast, the default, calls every connected Slot,
+         * the other modes call exactly one to distribute work across the connected Slots. If the
+         * selected Slot is suppressed by its sampling, rate limit or remaining deliveries, the next
+         * connected Slot that is not takes the emission, except with ConsistentHash where only the
+         * Slot owning the key may.
+         * ConsistentHash needs a key function, so it is set with the overload taking one. Selecting
+         * it here keeps the key function already set, or leaves the mode unchanged if there is none.
+         *
+         * @param delivery Delivery mode.
+         */
+        void setDelivery(Delivery delivery) {
+            Guard guard(lock);
+            if (delivery == Delivery::ConsistentHash && !(extension && extension->ring)) {
+                return;
+            }
+            auto &state = extended();
+            state.mode = delivery;
+            if (state.mode != Delivery::ConsistentHash) {
+                state.ring.reset();
+            }
+        }
+
+        /**
+         * Sets consistent hash delivery. Each emission is delivered to the one connected Slot that
+         * owns its key, and a Slot connecting or disconnecting only moves the keys next to its own
+         * points on the hash ring.
+         *
+         * @param key Function returning the key of an emission.
+         * @param virtualNodes Number of points on the hash ring for each connected Slot.
+         */
+        void setDelivery(std::function<std::size_t(Parameter<Args>...)> key, int virtualNodes = 64) {
+            Guard guard(lock);
+            auto &state = extended();
+            state.mode = Delivery::ConsistentHash;
+            state.ring.reset(new Ring(std::move(key), virtualNodes));
+            for (auto &connection : slots) {
+                state.ring->add(connection.slot);
+            }
+        }
+
+        /**
+         * Returns how each emission is delivered.
+         *
+         * @return Delivery mode.
+         */
+        Delivery delivery() const {
+            Guard guard(lock);
+            return extension ? extension->mode : Delivery::Broadcast;
+        }
+
+        /**
+         * Sets how the emissions of this Signal recorded during a Transaction are coalesced.
+         * KeepAll, the default, delivers every one. Merge is set with the overload taking a merge
+         * function.
+         *
+         * @param coalesce Coalescing policy.
+         */
+        void setCoalescing(Coalesce coalesce) {
+            Guard guard(lock);
+            recordingState().coalesce = coalesce;
+        }
+
+        /**
+         * Merges the emissions of this Signal recorded during a Transaction into one.
+         *
+         * @param merge Function merging the arguments of an emission into the arguments recorded so
+         * far.
+         */
+        void setCoalescing(std::function<void(Arguments &, Parameter<Args>...)> merge) {
+            Guard guard(lock);
+            auto &state = recordingState();
+            state.coalesce = Coalesce::Merge;
+            state.merge = std::move(merge);
+        }
+
+        /**
+         * Connects this Signal to the provided Slot unless already connected.
+         *
+         * @param slot Slot to connect this Signal to.
+         */
+        void connect(const SlotType &slot) {
+            connectWithPriority(slot, 0);
+        }
+
+        /**
+         * Connects this Signal to the provided Slot unless already connected. Slots with a higher
+         * priority are called first. Requires the PriorityOrder ordering policy.
+         *
+         * @param slot Slot to connect this Signal to.
+         * @param priority Priority of the connection.
+         */
+        void connect(const SlotType &slot, int priority) {
+            static_assert(Order::prioritized, "connecting with a priority requires the PriorityOrder policy");
+            connectWithPriority(slot, priority);
+        }
+
+        /**
+         * Connects this Signal to the provided Slot for its next delivery only.
+         *
+         * @param slot Slot to connect this Signal to.
+         */
+        void connectOnce(const SlotType &slot) {
+            connectFor(slot, 1);
+        }
+
+        /**
+         * Connects this Signal to the provided Slot for the provided number of deliveries, after
+         * which it is disconnected. Connecting an already connected Slot sets its remaining
+         * deliveries.
+         *
+         * Expired connections are skipped as soon as their last delivery is made and removed once
+         * the emit completes, without allocating.
+         *
+         * @param slot Slot to connect this Signal to.
+         * @param count Number of deliveries, at least 1.
+         */
+        void connectFor(const SlotType &slot, std::uint64_t count) {
+            std::lock(lock, slot.lock);
+            Guard guard(lock, std::adopt_lock);
+            Guard slotGuard(slot.lock, std::adopt_lock);
+            connectLocked(slot, 0);
+            auto *filter = filterFor(slot);
+            extension->expired -= filter->expired ? 1 : 0;
+            filter->shots = std::max<std::uint64_t>(count, 1);
+            filter->expired = false;
+        }
+
+        /**
+         * Disconnects this Signal from the provided Slot if connected.
+         *
+         * @param slot Slot to disconnect this Signal from.
+         */
+        void disconnect(const SlotType &slot) {
+            std::lock(lock, slot.lock);
+            Guard guard(lock, std::adopt_lock);
+            Guard slotGuard(slot.lock, std::adopt_lock);
+            this->removeSlot(slot);
+            slot.removeSignal(*this);
+        }
+
+        /**
+         * Disconnects this Signal from all connected Slot.
+         */
+        void disconnectAll() {
+            std::unique_lock<Lock> guard(lock);
+            while (!slots.empty()) {
+                auto *slot = slots.back().slot;
+                if (!slot->lock.try_lock()) {
+                    guard.unlock();
+                    std::this_thread::yield();
+                    guard.lock();
+                    continue;
+                }
+                slot->removeSignal(*this);
+                slots.pop_back();
+                forgetConnection(*slot, slots.size());
+                slot->lock.unlock();
+            }
+        }
+
+        /**
+         * Returns the number of connections for this Signal.
+         *
+         * @return Number of connections for this Signal.
+         */
+        int connectionCount() const {
+            Guard guard(lock);
+            return slots.size();
+        }
+
+        /**
+         * Returns true if this Signal is connected to the provided Slot.
+         *
+         * @param slot Slot to test connection against.
+         * @return true if connected.
+         */
+        bool isConnectedTo(const SlotType &slot) const {
+            Guard guard(lock);
+            return find(slot) != slots.end();
+        }
+
+        /**
+         * Returns the memory held by the connections and delivery state of this Signal.
+         *
+         * @return Memory usage of this Signal.
+         */
+        MemoryUsage memoryUsage() const {
+            Guard guard(lock);
+            MemoryUsage usage = detail::connectionListUsage(slots);
+            usage.stateBytes = extension ? extension->bytes() : 0;
+            return usage;
+        }
+
+        /**
+         * Releases unused capacity of the connection list, delivery filters and emission buffers of
+         * this Signal, e.g. after a burst of connections has been disconnected.
+         */
+        void shrinkToFit() {
+            Guard guard(lock);
+            slots.shrink_to_fit();
+            if (extension) {
+                extension->shrinkToFit();
+            }
+        }
+
+        /**
+         * Reserves capacity for the provided number of connections so that connecting does not
+         * allocate until it is exceeded.
+         *
+         * @param count Number of connections to reserve capacity for.
+         */
+        void reserve(int count) {
+            Guard guard(lock);
+            slots.reserve(count);
+        }
+
+    private:
+
+        void deliver(const SlotType &slot, detail::DeliveryFilter *filter, detail::EmissionEnvelope<Args...> &envelope,
+                     Parameter<Args>... args) {
+            if (filter != nullptr && !admit(*filter)) {
+                return;
+            }
+            if (!slot.receiver) {
+                ++calling;
+                struct Call {
+                    ~Call() { --signal.calling; }
+                    BasicSignal &signal;
+                } call{*this};
+                slot.callback(std::forward<Parameter<Args>>(args)...);
+            } else {
+                slot.post(envelope.get(std::forward<Parameter<Args>>(args)...));
+            }
+        }
+
+        bool admit(detail::DeliveryFilter &filter) {
+            auto admitted = filter.admit();
+            if (admitted && filter.expired) {
+                ++extension->expired;
+            }
+            return admitted;
+        }
+
+        detail::DeliveryFilter *filterAt(std::size_t index) {
+            return !extension || extension->filters.empty() ? nullptr : &extension->filters[index];
+        }
+
+        /**
+         * Disconnects the Slots whose connections have expired, unless a Slot function is still
+         * being called or a Slot is locked by another thread, in which case it is retried after a
+         * later emit.
+         */
+        void compact() {
+            if (!extension || extension->expired == 0 || calling != 0) {
+                return;
+            }
+            auto &filters = extension->filters;
+            for (std::size_t i = 0; i < filters.size();) {
+                if (!filters[i].expired) {
+                    i++;
+                    continue;
+                }
+                auto *slot = slots[i].slot;
+                if (!slot->lock.try_lock()) {
+                    i++;
+                    continue;
+                }
+                slot->removeSignal(*this);
+                removeSlot(*slot);
+                slot->lock.unlock();
+            }
+        }
+
+        detail::DeliveryFilter *filterFor(const SlotType &slot) {
+            auto connection = find(slot);
+            if (connection == slots.end()) {
+                return nullptr;
+            }
+            auto &filters = extended().filters;
+            if (filters.empty()) {
+                filters.resize(slots.size());
+            }
+            return &filters[connection - slots.begin()];
+        }
+
+        std::size_t select() {
+            auto count = slots.size();
+            auto &cursor = extension->cursor;
+            switch (extension->mode) {
+                case Delivery::LeastLoaded: {
+                    auto best = cursor++ % count;
+                    auto bestLoad = slots[best].slot->pendingCount();
+                    for (std::size_t i = 1; i < count && bestLoad > 0; i++) {
+                        auto candidate = (best + i) % count;
+                        auto load = slots[candidate].slot->pendingCount();
+                        if (load < bestLoad) {
+                            best = candidate;
+                            bestLoad = load;
+                        }
+                    }
+                    return best;
+                }
+                case Delivery::RandomOfTwo: {
+                    auto first = random() % count;
+                    auto second = random() % count;
+                    return slots[second].slot->pendingCount() < slots[first].slot->pendingCount() ? second : first;
+                }
+                default:
+                    return cursor++ % count;
+            }
+        }
+
+        std::uint32_t random() {
+            auto &seed = extension->seed;
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            return seed;
+        }
+
+        typename P::template Container<Connection>::const_iterator find(const SlotType &slot) const {
+            return std::find_if(slots.begin(), slots.end(), [&](const Connection &connection) {
+                return connection.slot == &slot;
+            });
+        }
+
+        void connectWithPriority(const SlotType &slot, int priority) {
+            std::lock(lock, slot.lock);
+            Guard guard(lock, std::adopt_lock);
+            Guard slotGuard(slot.lock, std::adopt_lock);
+            connectLocked(slot, priority);
+        }
+
+        void connectLocked(const SlotType &slot, int priority) {
+            if (find(slot) != slots.end()) {
+                return;
+            }
+            Order::insert(slots, Order::connection(slot, priority));
+            slot.addSignal(*this);
+            if (!extension) {
+                return;
+            }
+            if (extension->ring) {
+                extension->ring->add(&slot);
+            }
+            auto &filters = extension->filters;
+            if (!filters.empty()) {
+                filters.emplace(filters.begin() + (find(slot) - slots.begin()));
+            }
+        }
+
+        /**
+         * Connects the provided Slot with the priority and delivery filter of the connection of
+         * original, so that copying or moving a Slot keeps how it is delivered to.
+         */
+        void connectLike(const SlotType &slot, const SlotType &original) {
+            int priority = 0;
+            detail::DeliveryFilter filter;
+            bool filtered = false;
+            {
+                Guard guard(lock);
+                auto connection = find(original);
+                if (connection != slots.end()) {
+                    priority = Order::priority(*connection);
+                    if (auto *copied = filterAt(connection - slots.begin())) {
+                        filter = *copied;
+                        filtered = true;
+                    }
+                }
+            }
+            connectFiltered(slot, priority, filtered ? &filter : nullptr);
+        }
+
+        /**
+         * Connects the provided Slot then sets its delivery filter to a copy of the provided one,
+         * including the remaining deliveries of a connectFor() connection. A connection that has
+         * already made its last delivery is not copied.
+         */
+        void connectFiltered(const SlotType &slot, int priority, const detail::DeliveryFilter *filter) {
+            if (filter != nullptr && filter->expired) {
+                return;
+            }
+            std::lock(lock, slot.lock);
+            Guard guard(lock, std::adopt_lock);
+            Guard slotGuard(slot.lock, std::adopt_lock);
+            connectLocked(slot, priority);
+            if (filter != nullptr) {
+                auto *copy = filterFor(slot);
+                extension->expired -= copy->expired ? 1 : 0;
+                *copy = *filter;
+            }
+        }
+
+        void removeSlot(const SlotType &slot) {
+            auto connection = find(slot);
+            if (connection == slots.end()) {
+                return;
+            }
+            auto index = connection - slots.begin();
+            slots.erase(connection, connection + 1);
+            forgetConnection(slot, index);
+        }
+
+        /**
+         * Removes the hash ring points and delivery filter of a connection already removed from the
+         * connection list at the provided index.
+         */
+        void forgetConnection(const SlotType &slot, std::size_t index) {
+            if (!extension) {
+                return;
+            }
+            if (extension->ring) {
+                extension->ring->remove(&slot);
+            }
+            auto &filters = extension->filters;
+            if (!filters.empty()) {
+                extension->expired -= filters[index].expired ? 1 : 0;
+                filters.erase(filters.begin() + index);
+            }
+        }
+
+        void copyDeliveryFrom(const BasicSignal &other) {
+            Extension copied;
+            {
+                Guard guard(other.lock);
+                if (other.extension) {
+                    copied.mode = other.extension->mode;
+                    if (other.extension->ring) {
+                        copied.ring.reset(new Ring(other.extension->ring->key, other.extension->ring->virtualNodes));
+                    }
+                    copied.recording.coalesce = other.extension->recording.coalesce;
+                    copied.recording.merge = other.extension->recording.merge;
+                }
+            }
+            Guard guard(lock);
+            if (!extension && copied.mode == Delivery::Broadcast && copied.recording.coalesce == Coalesce::KeepAll) {
+                return;
+            }
+            auto &state = extended();
+            state.mode = copied.mode;
+            state.ring = std::move(copied.ring);
+            if (state.ring) {
+                for (auto &connection : slots) {
+                    state.ring->add(connection.slot);
+                }
+            }
+            state.recording.coalesce = copied.recording.coalesce;
+            state.recording.merge = std::move(copied.recording.merge);
+        }
+
+        void takeHeldFrom(BasicSignal &other) {
+            std::vector<Arguments> held;
+            bool paused = false;
+            {
+                Guard guard(other.lock);
+                if (other.extension) {
+                    auto &state = other.extension->recording;
+                    paused = state.paused;
+                    state.paused = false;
+                    std::swap(held, state.held);
+                }
+            }
+            Guard guard(lock);
+            if (!paused && !extension) {
+                return;
+            }
+            auto &state = recordingState();
+            state.paused = paused;
+            state.held = std::move(held);
+        }
+
+        Extension &extended() {
+            if (!extension) {
+                extension.reset(new Extension());
+            }
+            return *extension;
+        }
+
+        Recording &recordingState() {
+            return extended().recording;
+        }
+
+        BasicSignal *deliverUntilStopped(Parameter<Args>... args) {
+            Guard guard(lock);
+            auto &stopped = detail::propagationStopped();
+            detail::EmissionEnvelope<Args...> envelope;
+            for (std::size_t i = 0; i < slots.size(); i++) {
+                stopped = false;
+                deliver(*slots[i].slot, filterAt(i), envelope, std::forward<Parameter<Args>>(args)...);
+                if (stopped) {
+                    break;
+                }
+            }
+            compact();
+            return extension ? extension->parent : nullptr;
+        }
+
+        void deliverAll(Parameter<Args>... args) {
+            detail::PropagationScope scope;
+            detail::EmissionEnvelope<Args...> envelope;
+            auto mode = extension ? extension->mode : Delivery::Broadcast;
+            if (mode == Delivery::ConsistentHash) {
+                auto &ring = extension->ring;
+                if (ring && !ring->points.empty()) {
+                    auto *slot = ring->find(ring->key(std::forward<Parameter<Args>>(args)...));
+                    auto *filter = filterAt(find(*slot) - slots.begin());
+                    deliver(*slot, filter, envelope, std::forward<Parameter<Args>>(args)...);
+                }
+            } else if (mode != Delivery::Broadcast) {
+                auto count = slots.size();
+                auto selected = count == 0 ? 0 : select();
+                for (std::size_t i = 0; i < count; i++) {
+                    auto index = (selected + i) % count;
+                    auto *filter = filterAt(index);
+                    if (filter == nullptr || admit(*filter)) {
+                        deliver(*slots[index].slot, nullptr, envelope, std::forward<Parameter<Args>>(args)...);
+                        break;
+                    }
+                }
+            } else {
+                for (std::size_t i = 0; i < slots.size(); i++) {
+                    deliver(*slots[i].slot, filterAt(i), envelope, std::forward<Parameter<Args>>(args)...);
+                }
+            }
+            compact();
+        }
+
+        /**
+         * Adds an emission to a buffer whose entries from start on are coalesced.
+         *
+         * @return true if a new entry was added rather than coalesced into the last one.
+         */
+        bool append(std::vector<Arguments> &buffer, std::size_t start, Parameter<Args>... args) {
+            auto &state = recordingState();
+            if (state.coalesce == Coalesce::KeepAll || buffer.size() == start) {
+                buffer.emplace_back(own(args)...);
+                return true;
+            }
+            if (state.coalesce == Coalesce::Merge && state.merge) {
+                state.merge(buffer.back(), std::forward<Parameter<Args>>(args)...);
+            } else {
+                buffer.pop_back();
+                buffer.emplace_back(own(args)...);
+            }
+            return false;
+        }
+
+        void record(Parameter<Args>... args) {
+            bool first;
+            {
+                Guard guard(lock);
+                auto &state = recordingState();
+                first = append(state.pending, state.next, std::forward<Parameter<Args>>(args)...);
+            }
+            if (first) {
+                detail::transactions().recorded.push_back({&BasicSignal::flushNext, this});
+            }
+        }
+
+        static void flushNext(void *target) {
+            auto &signal = *static_cast<BasicSignal *>(target);
+            std::unique_lock<Lock> guard(signal.lock);
+            auto &state = signal.extension->recording;
+            Arguments arguments(std::move(state.pending[state.next++]));
+            if (state.next == state.pending.size()) {
+                state.pending.clear();
+                state.next = 0;
+            }
+            guard.unlock();
+            detail::apply<Args...>([&](Parameter<Args>... args) {
+                signal.emit(std::forward<Parameter<Args>>(args)...);
+            }, arguments, std::index_sequence_for<Args...>());
+        }
+
+        static void flushFrame(void *target) {
+            auto &signal = *static_cast<BasicSignal *>(target);
+            Guard guard(signal.lock);
+            detail::PropagationScope scope;
+            auto &state = signal.extension->recording;
+            std::swap(state.framed, state.delivering);
+            if (signal.extension->mode == Delivery::Broadcast) {
+                state.envelopes.resize(state.delivering.size());
+                for (std::size_t i = 0; i < signal.slots.size(); i++) {
+                    for (std::size_t e = 0; e < state.delivering.size(); e++) {
+                        detail::applyShared<Args...>([&](Parameter<Args>... args) {
+                            signal.deliver(*signal.slots[i].slot, signal.filterAt(i), state.envelopes[e],
+                                           std::forward<Parameter<Args>>(args)...);
+                        }, state.delivering[e], std::index_sequence_for<Args...>());
+                    }
+                }
+                state.envelopes.clear();
+            } else {
+                for (auto &arguments : state.delivering) {
+                    detail::apply<Args...>([&](Parameter<Args>... args) {
+                        signal.deliverAll(std::forward<Parameter<Args>>(args)...);
+                    }, arguments, std::index_sequence_for<Args...>());
+                }
+            }
+            state.delivering.clear();
+            signal.compact();
+        }
+
+        void forgetRecorded() {
+            if (!extension) {
+                return;
+            }
+            auto &recording = extension->recording;
+            if (recording.dispatcher) {
+                recording.dispatcher->remove(this);
+            }
+            if (recording.pending.size() != recording.next) {
+                detail::transactions().forget(this);
+            }
+        }
+
+        /**
+         * Reads each connection of other under its lock but connects without it, so that copying
+         * a Signal and its Slot on two threads can not lock them in opposite order.
+         */
+        void copyConnectionsFrom(const BasicSignal &other) {
+            for (std::size_t i = 0;; i++) {
+                Connection connection{};
+                detail::DeliveryFilter filter;
+                bool filtered = false;
+                {
+                    Guard guard(other.lock);
+                    if (i >= other.slots.size()) {
+                        return;
+                    }
+                    connection = other.slots[i];
+                    if (other.extension && !other.extension->filters.empty()) {
+                        filter = other.extension->filters[i];
+                        filtered = true;
+                    }
+                }
+                connectFiltered(*connection.slot, Order::priority(connection), filtered ? &filter : nullptr);
+            }
+        }
+
+    private:
+
+        mutable Lock lock;
+
+        int calling = 0;
+
+        std::unique_ptr<Extension> extension;
+
+        typename P::template Container<Connection> slots;
+
+    };
+
+    /**
+     * Signal using the default policy: single threaded, vector storage and insertion order.
+     */
+    template<typename... Args>
+    using Signal = BasicSignal<DefaultPolicy, Args...>;
+
+    /**
+     * Slot using the default policy: single threaded, vector storage and insertion order.
+     */
+    template<typename... Args>
+    using Slot = BasicSlot<DefaultPolicy, Args...>;
+
+    namespace detail {
+
+        template<typename... Args>
+        struct BatchElement {
+            using type = std::tuple<Owned<Args>...>;
+        };
+
+        template<typename Arg>
+        struct BatchElement<Arg> {
+            using type = Owned<Arg>;
+        };
+    }
+
+    /**
+     * Slot adaptor that accumulates emissions and delivers them to its function as one batch.
+     *
+     * A batch is delivered when it reaches the maximum size, when an emission arrives after the
+     * maximum delay since the first emission of the batch, on poll() once that delay has passed, on
+     * flush() and on destruction. The batch buffer is reserved up front and reused, so accumulating
+     * does not allocate for arguments whose copies do not allocate.
+     *
+     * Each batch element is the owned argument for a single argument Signal, otherwise a tuple of
+     * the owned arguments.
+     */
+    template<typename P, typename... Args>
+    class BasicBatchingSlot final {
+
+        using Clock = std::chrono::steady_clock;
+        using Guard = std::lock_guard<typename P::Lock>;
+
+    public:
+
+        using Element = typename detail::BatchElement<Args...>::type;
+        using Batch = Payload<Element>;
+        using Function = std::function<void(const Batch &)>;
+
+        /**
+         * @param maxSize Number of emissions that triggers delivery.
+         * @param maxDelay Age of the oldest emission that triggers delivery, zero for no limit.
+         * @param function Function to deliver each batch to.
+         */
+        BasicBatchingSlot(std::size_t maxSize, Clock::duration maxDelay, Function function)
+                : maxSize(std::max<std::size_t>(maxSize, 1)), maxDelay(maxDelay), function(std::move(function)) {
+            buffer.reserve(this->maxSize);
+        }
+
+        /**
+         * @param maxSize Number of emissions that triggers delivery.
+         * @param function Function to deliver each batch to.
+         */
+        BasicBatchingSlot(std::size_t maxSize, Function function)
+                : BasicBatchingSlot(maxSize, Clock::duration::zero(), std::move(function)) {}
+
+        BasicBatchingSlot(const BasicBatchingSlot &) = delete;
+
+        BasicBatchingSlot &operator=(const BasicBatchingSlot &) = delete;
+
+        ~BasicBatchingSlot() {
+            flush();
+        }
+
+        /**
+         * Returns the Slot to connect Signals to.
+         *
+         * @return Slot that accumulates emissions.
+         */
+        const BasicSlot<P, Args...> &slot() const {
+            return receiver;
+        }
+
+        /**
+         * Delivers the accumulated emissions, if any.
+         */
+        void flush() {
+            Guard guard(lock);
+            deliver();
+        }
+
+        /**
+         * Delivers the accumulated emissions if the oldest is older than the maximum delay.
+         *
+         * @return true if a batch was delivered.
+         */
+        bool poll() {
+            Guard guard(lock);
+            if (buffer.empty() || !expired(Clock::now())) {
+                return false;
+            }
+            deliver();
+            return true;
+        }
+
+        /**
+         * Returns the number of accumulated emissions.
+         *
+         * @return Number of accumulated emissions.
+         */
+        std::size_t size() const {
+            Guard guard(lock);
+            return buffer.size();
+        }
+
+    private:
+
+        void add(Parameter<Args>... args) {
+            Guard guard(lock);
+            bool timed = maxDelay != Clock::duration::zero();
+            auto now = timed ? Clock::now() : Clock::time_point();
+            if (buffer.empty()) {
+                first = now;
+            }
+            buffer.emplace_back(own(args)...);
+            if (buffer.size() >= maxSize || (timed && expired(now))) {
+                deliver();
+            }
+        }
+
+        bool expired(Clock::time_point now) const {
+            return maxDelay != Clock::duration::zero() && now - first >= maxDelay;
+        }
+
+        void deliver() {
+            if (!buffer.empty()) {
+                function(Batch(buffer.data(), buffer.size()));
+                buffer.clear();
+            }
+        }
+
+    private:
+
+        const std::size_t maxSize;
+        const Clock::duration maxDelay;
+        Function function;
+
+        mutable typename P::Lock lock;
+        std::vector<Element> buffer;
+        Clock::time_point first;
+
+        BasicSlot<P, Args...> receiver{[this](Parameter<Args>... args) { add(args...); }};
+
+    };
+
+    /**
+     * BatchingSlot using the default policy.
+     */
+    template<typename... Args>
+    using BatchingSlot = BasicBatchingSlot<DefaultPolicy, Args...>;
+
+    namespace detail {
+
+        /**
+         * Fixed capacity buffer of trivially copyable values aligned to a cache line, so that
+         * loops over it can use aligned vector loads.
+         */
+        template<typename T>
+        class AlignedColumn {
+
+            static_assert(std::is_trivially_copyable<T>::value, "batch columns must be trivially copyable");
+
+        public:
+
+            static constexpr std::size_t alignment = 64;
+
+            explicit AlignedColumn(std::size_t capacity)
+                    : memory(new unsigned char[capacity * sizeof(T) + alignment]) {
+                auto address = reinterpret_cast<std::uintptr_t>(memory.get());
+                values = reinterpret_cast<T *>((address + alignment - 1) & ~(alignment - 1));
+            }
+
+            T *data() const { return values; }
+
+            T &operator[](std::size_t index) const { return values[index]; }
+
+        private:
+
+            std::unique_ptr<unsigned char[]> memory;
+            T *values;
+        };
+    }
+
+    /**
+     * Slot that receives a batch from a BasicBatchSignal as one contiguous column per argument.
+     */
+    template<typename P, typename... Args>
+    using BasicBatchSlot = BasicSlot<P, Payload<Args>...>;
+
+    /**
+     * Signal that buffers emitted arguments column-wise and delivers them in batches.
+     *
+     * Batch Slots receive one aligned, contiguous Payload per argument for the whole batch so that
+     * their bodies can vectorize. Ordinary Slots are called once per buffered emission, in order.
+     * A batch is delivered when the buffer is full, on flush() and on destruction.
+     */
+    template<typename P, typename... Args>
+    class BasicBatchSignal final {
+
+        static_assert(sizeof...(Args) > 0, "BatchSignal requires at least one argument");
+
+        using Guard = std::lock_guard<typename P::Lock>;
+
+    public:
+
+        using ElementSlot = BasicSlot<P, Args...>;
+        using BatchSlot = BasicBatchSlot<P, Args...>;
+
+        /**
+         * @param batchSize Number of emissions buffered before a batch is delivered.
+         */
+        explicit BasicBatchSignal(std::size_t batchSize)
+                : capacity(std::max<std::size_t>(batchSize, 1)), columns(detail::AlignedColumn<Args>(capacity)...) {}
+
+        BasicBatchSignal(const BasicBatchSignal &) = delete;
+
+        BasicBatchSignal &operator=(const BasicBatchSignal &) = delete;
+
+        ~BasicBatchSignal() {
+            flush();
+        }
+
+        /**
+         * Buffers the arguments, delivering the batch if the buffer is full.
+         *
+         * @param args Arguments to buffer.
+         */
+        void emit(Parameter<Args>... args) {
+            Guard guard(lock);
+            store(count, std::index_sequence_for<Args...>(), args...);
+            if (++count == capacity) {
+                deliver(std::index_sequence_for<Args...>());
+            }
+        }
+
+        /**
+         * Delivers the buffered emissions, if any.
+         */
+        void flush() {
+            Guard guard(lock);
+            deliver(std::index_sequence_for<Args...>());
+        }
+
+        /**
+         * Connects this Signal to a Slot that is called once per buffered emission.
+         *
+         * @param slot Slot to connect this Signal to.
+         */
+        void connect(const ElementSlot &slot) {
+            elements.connect(slot);
+        }
+
+        /**
+         * Connects this Signal to a Slot that is called once per batch.
+         *
+         * @param slot Slot to connect this Signal to.
+         */
+        void connect(const BatchSlot &slot) {
+            batches.connect(slot);
+        }
+
+        void disconnect(const ElementSlot &slot) {
+            elements.disconnect(slot);
+        }
+
+        void disconnect(const BatchSlot &slot) {
+            batches.disconnect(slot);
+        }
+
+        /**
+         * Returns the number of connections for this Signal.
+         *
+         * @return Number of connections for this Signal.
+         */
+        int connectionCount() const {
+            return elements.connectionCount() + batches.connectionCount();
+        }
+
+        /**
+         * Returns the number of buffered emissions.
+         *
+         * @return Number of buffered emissions.
+         */
+        std::size_t size() const {
+            Guard guard(lock);
+            return count;
+        }
+
+    private:
+
+        template<std::size_t... I>
+        void store(std::size_t index, std::index_sequence<I...>, Parameter<Args>... args) {
+            int expand[] = {(std::get<I>(columns)[index] = args, 0)...};
+            (void) expand;
+        }
+
+        template<std::size_t... I>
+        void deliver(std::index_sequence<I...>) {
+            if (count == 0) {
+                return;
+            }
+            batches.emit(Payload<Args>(std::get<I>(columns).data(), count)...);
+            if (elements.connectionCount() > 0) {
+                for (std::size_t i = 0; i < count; i++) {
+                    elements.emit(std::get<I>(columns)[i]...);
+                }
+            }
+            count = 0;
+        }
+
+    private:
+
+        const std::size_t capacity;
+        std::tuple<detail::AlignedColumn<Args>...> columns;
+        std::size_t count = 0;
+        mutable typename P::Lock lock;
+
+        BasicSignal<P, Payload<Args>...> batches;
+        BasicSignal<P, Args...> elements;
+
+    };
+
+    /**
+     * BatchSignal using the default policy.
+     */
+    template<typename... Args>
+    using BatchSignal = BasicBatchSignal<DefaultPolicy, Args...>;
+
+    /**
+     * BatchSlot using the default policy.
+     */
     template<typename... Args>
-    class Signal;
+    using BatchSlot = BasicBatchSlot<DefaultPolicy, Args...>;
+
+    namespace detail {
+
+        /**
+         * Reductions written with independent accumulators so that compilers can vectorize them.
+         */
+        template<typename T>
+        T reduceSum(const T *first, const T *last, T initial) {
+            T partial[4] = {};
+            for (; last - first >= 4; first += 4) {
+                partial[0] += first[0];
+                partial[1] += first[1];
+                partial[2] += first[2];
+                partial[3] += first[3];
+            }
+            for (; first != last; ++first) {
+                initial += *first;
+            }
+            return initial + ((partial[0] + partial[1]) + (partial[2] + partial[3]));
+        }
+
+        template<typename T, typename Select>
+        T reduce(const T *first, const T *last, T initial, Select select) {
+            T partial[4] = {initial, initial, initial, initial};
+            for (; last - first >= 4; first += 4) {
+                partial[0] = select(partial[0], first[0]);
+                partial[1] = select(partial[1], first[1]);
+                partial[2] = select(partial[2], first[2]);
+                partial[3] = select(partial[3], first[3]);
+            }
+            for (; first != last; ++first) {
+                initial = select(initial, *first);
+            }
+            return select(select(initial, select(partial[0], partial[1])), select(partial[2], partial[3]));
+        }
+    }
+
+    /**
+     * Receiver that keeps the most recent values emitted by the Signals it is connected to and
+     * computes aggregates over them.
+     *
+     * A count window keeps the last N values and a time window keeps the values emitted within a
+     * duration. Values are kept in a ring buffer and aggregates are computed on read with vectorizable
+     * reductions, so a single window can be connected once and shared by any number of readers, who
+     * can connect to updated to be told when a value is added.
+     */
+    template<typename P, typename T>
+    class BasicWindow final {
+
+        static_assert(std::is_arithmetic<T>::value, "Window values must be arithmetic");
+
+        using Clock = std::chrono::steady_clock;
+        using Guard = std::lock_guard<typename P::Lock>;
+
+    public:
+
+        /**
+         * Creates a count window.
+         *
+         * @param count Number of most recent values to keep.
+         */
+        explicit BasicWindow(std::size_t count)
+                : limit(std::max<std::size_t>(count, 1)), duration(Clock::duration::zero()), values(limit) {}
+
+        /**
+         * Creates a time window.
+         *
+         * @param duration Age beyond which values are dropped.
+         * @param capacity Initial capacity of the ring buffer, which grows as needed.
+         */
+        explicit BasicWindow(Clock::duration duration, std::size_t capacity = 64)
+                : limit(0), duration(duration), values(std::max<std::size_t>(capacity, 1)),
+                  times(values.size()) {}
+
+        BasicWindow(const BasicWindow &) = delete;
+
+        BasicWindow &operator=(const BasicWindow &) = delete;
+
+        /**
+         * Returns the Slot to connect Signals to.
+         *
+         * @return Slot that adds emitted values to this window.
+         */
+        const BasicSlot<P, T> &slot() const {
+            return receiver;
+        }
+
+        /**
+         * Returns the number of values in the window.
+         *
+         * @return Number of values.
+         */
+        std::size_t count() const {
+            Guard guard(lock);
+            expire();
+            return size;
+        }
+
+        /**
+         * @return Sum of the values in the window, 0 when empty.
+         */
+        T sum() const {
+            Guard guard(lock);
+            expire();
+            return total();
+        }
 
-    template<typename... Args>
-    class Slot final {
+        /**
+         * @return Smallest value in the window, 0 when empty.
+         */
+        T min() const {
+            Guard guard(lock);
+            expire();
+            return size == 0 ? T() : reduce(values[head], [](const T *first, const T *last, T initial) {
+                return detail::reduce(first, last, initial, [](T a, T b) { return b < a ? b : a; });
+            });
+        }
 
-        friend class Signal<Args...>;
+        /**
+         * @return Largest value in the window, 0 when empty.
+         */
+        T max() const {
+            Guard guard(lock);
+            expire();
+            return size == 0 ? T() : reduce(values[head], [](const T *first, const T *last, T initial) {
+                return detail::reduce(first, last, initial, [](T a, T b) { return a < b ? b : a; });
+            });
+        }
 
-    public:
+        /**
+         * @return Mean of the values in the window, 0 when empty.
+         */
+        double mean() const {
+            Guard guard(lock);
+            expire();
+            return size == 0 ? 0.0 : static_cast<double>(total()) / size;
+        }
 
-        Slot() = default;
+        /**
+         * Emitted after each value is added.
+         */
+        BasicSignal<P> updated;
 
-        explicit Slot(std::function<void(Args...)> callback)
-                : callback(std::move(callback)) {}
+    private:
 
-        template<typename T>
-        Slot(T *instance, void (T::*function)(Args...))
-                : Slot([=](Args... args) { (instance->*function)(args...); }) {}
+        bool timed() const {
+            return limit == 0;
+        }
 
-        ~Slot() {
-            disconnectAll();
+        void add(T value) {
+            {
+                Guard guard(lock);
+                if (timed()) {
+                    expire();
+                    if (size == values.size()) {
+                        grow();
+                    }
+                } else if (size == limit) {
+                    head = next(head);
+                    --size;
+                }
+                auto tail = index(size);
+                values[tail] = value;
+                if (timed()) {
+                    times[tail] = Clock::now();
+                }
+                ++size;
+            }
+            updated.emit();
+        }
+
+        void expire() const {
+            if (!timed() || size == 0) {
+                return;
+            }
+            auto oldest = Clock::now() - duration;
+            while (size > 0 && times[head] < oldest) {
+                head = next(head);
+                --size;
+            }
+        }
+
+        void grow() {
+            std::vector<T> grownValues(values.size() * 2);
+            std::vector<Clock::time_point> grownTimes(grownValues.size());
+            for (std::size_t i = 0; i < size; i++) {
+                grownValues[i] = values[index(i)];
+                grownTimes[i] = times[index(i)];
+            }
+            values.swap(grownValues);
+            times.swap(grownTimes);
+            head = 0;
+        }
+
+        std::size_t index(std::size_t offset) const {
+            return (head + offset) % values.size();
+        }
+
+        std::size_t next(std::size_t position) const {
+            return position + 1 == values.size() ? 0 : position + 1;
+        }
+
+        T total() const {
+            return reduce(T(), [](const T *first, const T *last, T initial) {
+                return detail::reduceSum(first, last, initial);
+            });
         }
 
         /**
-         * Copies all connections of other Slot to this Slot.
-         * @param other Slot to copy connections from.
+         * Applies a reduction to the contiguous segments of the ring buffer.
          */
-        Slot(const Slot &other) {
-            copyConnectionsFrom(other);
-            this->callback = other.callback;
+        template<typename Reduction>
+        T reduce(T initial, Reduction reduction) const {
+            const T *data = values.data();
+            auto first = std::min(size, values.size() - head);
+            auto result = reduction(data + head, data + head + first, initial);
+            return reduction(data, data + (size - first), result);
         }
 
+    private:
+
+        const std::size_t limit;
+        const Clock::duration duration;
+        mutable typename P::Lock lock;
+        std::vector<T> values;
+        std::vector<Clock::time_point> times;
+        mutable std::size_t head = 0;
+        mutable std::size_t size = 0;
+
+        BasicSlot<P, T> receiver{[this](T value) { add(value); }};
+
+    };
+
+    /**
+     * Window using the default policy.
+     */
+    template<typename T>
+    using Window = BasicWindow<DefaultPolicy, T>;
+
+    class Graph;
+
+    namespace detail {
+
         /**
-         * Replaces connections of this Slot with connections of other Slot.
-         * @param other Slot to copy connections from.
-         * @return Copy assigned instance.
+         * Node of a Graph. A node's rank is greater than the rank of every node it is computed
+         * from, so updating nodes in rank order computes each one after all of its inputs.
          */
-        Slot &operator=(const Slot &other) {
-            disconnectAll();
-            copyConnectionsFrom(other);
-            this->callback = other.callback;
-            return *this;
+        class GraphNode {
+        public:
+
+            GraphNode(Graph &graph, std::vector<GraphNode *> parents);
+
+            virtual ~GraphNode();
+
+            GraphNode(const GraphNode &) = delete;
+
+            GraphNode &operator=(const GraphNode &) = delete;
+
+            /**
+             * Recomputes the value of this node from its inputs.
+             *
+             * @return true if the value changed.
+             */
+            virtual bool recompute() = 0;
+
+            /**
+             * Notifies observers that the value of this node changed.
+             */
+            virtual void notify() = 0;
+
+            Graph &graph;
+            const int rank;
+            bool queued = false;
+            bool pendingNotify = false;
+            std::vector<GraphNode *> parents;
+            std::vector<GraphNode *> children;
         };
+    }
+
+    /**
+     * Propagates changes through Cells and the Computed values derived from them.
+     *
+     * Each update is propagated in one pass in rank order, so every Computed value is recomputed at
+     * most once per update, after all of its inputs, and never observes a mix of old and new inputs.
+     * Observers are notified once the pass is complete; Cells they set are propagated in a further
+     * pass. If an observer throws, the nodes not yet notified are notified after the next update. Setting several Cells within a transaction propagates them together when it ends.
+     *
+     * A Graph and its nodes must only be used from one thread at a time. Nodes must be destroyed
+     * before the Graph and before the nodes they are computed from.
+     */
+    class Graph final {
+
+        friend class detail::GraphNode;
+
+    public:
+
+        Graph() = default;
+
+        Graph(const Graph &) = delete;
+
+        Graph &operator=(const Graph &) = delete;
 
         /**
-         * Copies all connections of other Slot to this Slot then disconnects other Slot.
-         * @param other Slot to copy connections from.
+         * Calls the provided function then propagates every Cell it set in one pass.
+         *
+         * @param function Function that sets Cells of this Graph.
          */
-        Slot(Slot &&other) noexcept {
-            copyConnectionsFrom(other);
-            other.disconnectAll();
-            std::swap(this->callback, other.callback);
+        template<typename F>
+        void transaction(F &&function) {
+            ++depth;
+            struct End {
+                ~End() { graph.end(); }
+                Graph &graph;
+            } end{*this};
+            function();
         }
 
         /**
-         * Replaces connections of this Slot with connections of other Slot then disconnects other
-         * Slot.
-         * @param other Slot to copy connections from.
-         * @return Move assigned instance.
+         * Returns the number of recomputations run by this Graph.
+         *
+         * @return Number of times a Computed value was recomputed.
          */
-        Slot &operator=(Slot &&other) noexcept {
-            disconnectAll();
-            copyConnectionsFrom(other);
-            other.disconnectAll();
-            std::swap(this->callback, other.callback);
-            return *this;
+        std::size_t recomputeCount() const {
+            return recomputes;
         }
 
         /**
-         * Returns the number of connections for this Slot.
+         * Marks the provided node as changed and queues the nodes computed from it.
+         */
+        void invalidate(detail::GraphNode &node);
+
+    private:
+
+        void end() {
+            if (--depth == 0) {
+                propagate();
+            }
+        }
+
+        void propagate();
+
+        void forget(detail::GraphNode &node);
+
+        static bool later(const detail::GraphNode *a, const detail::GraphNode *b) {
+            return a->rank > b->rank;
+        }
+
+    private:
+
+        int depth = 0;
+        std::size_t recomputes = 0;
+        std::vector<detail::GraphNode *> queue;
+        std::vector<detail::GraphNode *> updated;
+        bool notifying = false;
+    };
+
+    namespace detail {
+
+        inline GraphNode::GraphNode(Graph &graph, std::vector<GraphNode *> parents)
+                : graph(graph), rank(std::accumulate(parents.begin(), parents.end(), 0, [](int rank, GraphNode *parent) {
+                    return std::max(rank, parent->rank + 1);
+                })), parents(std::move(parents)) {
+            for (auto *parent : this->parents) {
+                parent->children.push_back(this);
+            }
+        }
+
+        inline GraphNode::~GraphNode() {
+            for (auto *parent : parents) {
+                parent->children.erase(std::remove(parent->children.begin(), parent->children.end(), this),
+                                       parent->children.end());
+            }
+            graph.forget(*this);
+        }
+    }
+
+    inline void Graph::invalidate(detail::GraphNode &node) {
+        if (!node.pendingNotify) {
+            node.pendingNotify = true;
+            updated.push_back(&node);
+        }
+        for (auto *child : node.children) {
+            if (!child->queued) {
+                child->queued = true;
+                queue.push_back(child);
+                std::push_heap(queue.begin(), queue.end(), later);
+            }
+        }
+        if (depth == 0) {
+            propagate();
+        }
+    }
+
+    inline void Graph::propagate() {
+        {
+            ++depth;
+            struct Pass {
+                ~Pass() { --graph.depth; }
+                Graph &graph;
+            } pass{*this};
+            while (!queue.empty()) {
+                std::pop_heap(queue.begin(), queue.end(), later);
+                auto *node = queue.back();
+                queue.pop_back();
+                node->queued = false;
+                ++recomputes;
+                if (node->recompute()) {
+                    invalidate(*node);
+                }
+            }
+        }
+
+        if (notifying) {
+            return;
+        }
+        notifying = true;
+        struct Notify {
+            ~Notify() {
+                graph.updated.erase(graph.updated.begin(), graph.updated.begin() + notified);
+                graph.notifying = false;
+            }
+            Graph &graph;
+            std::size_t notified;
+        } notify{*this, 0};
+        while (notify.notified < updated.size()) {
+            if (auto *node = updated[notify.notified++]) {
+                node->pendingNotify = false;
+                node->notify();
+            }
+        }
+    }
+
+    inline void Graph::forget(detail::GraphNode &node) {
+        queue.erase(std::remove(queue.begin(), queue.end(), &node), queue.end());
+        std::make_heap(queue.begin(), queue.end(), later);
+        std::replace(updated.begin(), updated.end(), &node, static_cast<detail::GraphNode *>(nullptr));
+    }
+
+    /**
+     * Input value of a Graph, set directly or by the Signals connected to its Slot.
+     *
+     * @tparam T Type of value, compared with == so that setting an equal value does nothing.
+     */
+    template<typename P, typename T>
+    class BasicCell final : public detail::GraphNode {
+    public:
+
+        /**
+         * Creates a Cell in the provided Graph.
          *
-         * @return Number of connections for this Slot.
+         * @param graph Graph to propagate changes through.
+         * @param value Initial value.
          */
-        int connectionCount() const {
-            return signals.size();
+        explicit BasicCell(Graph &graph, T value = T())
+                : GraphNode(graph, {}), value(std::move(value)) {}
+
+        /**
+         * Sets the value and, unless it is equal to the current value, propagates the change.
+         *
+         * @param value New value.
+         */
+        void set(Parameter<T> value) {
+            if (!(this->value == value)) {
+                this->value = value;
+                graph.invalidate(*this);
+            }
         }
 
         /**
-         * Returns true if this Slot is connected to the provided Signal.
+         * @return Current value.
+         */
+        const T &get() const {
+            return value;
+        }
+
+        /**
+         * Returns the Slot to connect Signals to.
          *
-         * @param signal Signal to test connection against.
-         * @return true if connected.
+         * @return Slot that sets this Cell to emitted values.
          */
-        bool isConnectedTo(const Signal<Args...> &signal) const {
-            return std::find(signals.begin(), signals.end(), &signal) != signals.end();
+        const BasicSlot<P, T> &slot() const {
+            return receiver;
         }
 
+        /**
+         * Emitted with the new value once the change has propagated through the Graph.
+         */
+        BasicSignal<P, T> changed;
+
     private:
 
-        void addSignal(Signal<Args...> &signal) const {
-            signals.push_back(&signal);
+        bool recompute() override {
+            return false;
         }
 
-        void removeSignal(Signal<Args...> &signal) const {
-            signals.erase(std::remove(signals.begin(), signals.end(), &signal), signals.end());
+        void notify() override {
+            changed.emit(value);
         }
 
-        void disconnectAll() {
-            for (auto *signal : signals) {
-                signal->removeSlot(*this);
-            }
-            signals.clear();
+    private:
+
+        T value;
+
+        BasicSlot<P, T> receiver{[this](Parameter<T> value) { set(value); }};
+
+    };
+
+    /**
+     * Value of a Graph computed from Cells and other Computed values.
+     *
+     * @tparam T Type of value, compared with == so that a recomputed equal value stops propagation.
+     */
+    template<typename P, typename T>
+    class BasicComputed final : public detail::GraphNode {
+    public:
+
+        /**
+         * Creates a Computed value from the provided inputs and computes its initial value.
+         *
+         * @param graph Graph to propagate changes through.
+         * @param function Function called with the values of the inputs.
+         * @param inputs Cells or Computed values of the same Graph.
+         */
+        template<typename F, typename... Inputs>
+        BasicComputed(Graph &graph, F function, Inputs &... inputs)
+                : GraphNode(graph, {&inputs...}), compute([function, &inputs...]() { return function(inputs.get()...); }),
+                  value(compute()) {}
+
+        /**
+         * @return Current value.
+         */
+        const T &get() const {
+            return value;
         }
 
-        void copyConnectionsFrom(const Slot<Args...> &other) {
-            for (auto *signal : other.signals) {
-                signal->connect(*this);
+        /**
+         * Emitted with the new value once the change has propagated through the Graph.
+         */
+        BasicSignal<P, T> changed;
+
+    private:
+
+        bool recompute() override {
+            T computed = compute();
+            if (value == computed) {
+                return false;
             }
+            value = std::move(computed);
+            return true;
+        }
+
+        void notify() override {
+            changed.emit(value);
         }
 
     private:
 
-        std::function<void(Args...)> callback;
+        std::function<T()> compute;
 
-        mutable std::vector<Signal<Args...> *> signals;
+        T value;
 
     };
 
-    template<typename... Args>
-    class Signal final {
+    /**
+     * Cell using the default policy.
+     */
+    template<typename T>
+    using Cell = BasicCell<DefaultPolicy, T>;
 
-        friend class Slot<Args...>;
+    /**
+     * Computed using the default policy.
+     */
+    template<typename T>
+    using Computed = BasicComputed<DefaultPolicy, T>;
+
+    /**
+     * Value computed on read from inputs that notify changes through Signals.
+     *
+     * An emission of any input Signal only marks the value dirty, it is recomputed by the next
+     * get(). The invalidated Signal is emitted when a clean value becomes dirty, so Memos computed
+     * from other Memos depend on their invalidated Signal and a chain of values that is not read
+     * costs one flag per change.
+     *
+     * @tparam T Type of value, default constructible.
+     */
+    template<typename P, typename T>
+    class BasicMemo final {
+
+        using Guard = std::lock_guard<typename P::Lock>;
 
     public:
 
-        Signal() = default;
+        /**
+         * Creates a dirty Memo.
+         *
+         * @param function Function computing the value.
+         * @param inputs Signals whose emissions invalidate the value.
+         */
+        template<typename F, typename... Signals>
+        explicit BasicMemo(F function, Signals &... inputs)
+                : compute(std::move(function)) {
+            int expand[] = {0, (dependsOn(inputs), 0)...};
+            (void) expand;
+        }
+
+        BasicMemo(const BasicMemo &) = delete;
 
-        ~Signal() {
-            disconnectAll();
+        BasicMemo &operator=(const BasicMemo &) = delete;
+
+        /**
+         * Adds a Signal whose emissions invalidate the value.
+         *
+         * @param signal Signal to depend on.
+         */
+        template<typename... Args>
+        void dependsOn(BasicSignal<P, Args...> &signal) {
+            auto slot = std::make_shared<BasicSlot<P, Args...>>([this](Parameter<Args>...) { invalidate(); });
+            signal.connect(*slot);
+            Guard guard(lock);
+            inputs.push_back(std::move(slot));
         }
 
         /**
-         * Copies all connections of other Signal to this Signal.
-         * @param other Signal to copy connections from.
+         * Returns the value, recomputing it first if an input changed since it was last computed.
+         *
+         * @return Current value, valid until the next get() after an input changes.
          */
-        Signal(const Signal &other) {
-            copyConnectionsFrom(other);
+        const T &get() const {
+            Guard guard(lock);
+            if (dirty) {
+                value = compute();
+                dirty = false;
+            }
+            return value;
         }
 
         /**
-         * Replaces connections of this Signal with connections of other Signal.
-         * @param other Signal to copy connections from.
-         * @return Copy assigned instance.
+         * @return true if the value will be recomputed by the next get().
          */
-        Signal &operator=(const Signal &other) {
-            disconnectAll();
-            copyConnectionsFrom(other);
-            return *this;
-        };
+        bool isDirty() const {
+            Guard guard(lock);
+            return dirty;
+        }
 
         /**
-         * Copies all connections of other Signal to this Signal then disconnects other Signal.
-         * @param other Signal to copy connections from.
+         * Marks the value dirty and, if it was clean, emits invalidated.
          */
-        Signal(Signal &&other) noexcept {
-            copyConnectionsFrom(other);
-            other.disconnectAll();
+        void invalidate() {
+            bool wasDirty;
+            {
+                Guard guard(lock);
+                wasDirty = dirty;
+                dirty = true;
+            }
+            if (!wasDirty) {
+                invalidated.emit();
+            }
         }
 
         /**
-         * Replaces connections of this Signal with connections of other Signal then disconnects other
-         * Signal.
-         * @param other Signal to copy connections from.
-         * @return Move assigned instance.
+         * Emitted when the value becomes dirty.
          */
-        Signal &operator=(Signal &&other) noexcept {
-            disconnectAll();
-            copyConnectionsFrom(other);
-            other.disconnectAll();
-            return *this;
+        BasicSignal<P> invalidated;
+
+    private:
+
+        std::function<T()> compute;
+        mutable typename P::Lock lock;
+        mutable bool dirty = true;
+        mutable T value;
+        std::vector<std::shared_ptr<void>> inputs;
+
+    };
+
+    /**
+     * Memo using the default policy.
+     */
+    template<typename T>
+    using Memo = BasicMemo<DefaultPolicy, T>;
+
+    /**
+     * Defers the notifications of Properties set on this thread until it commits, then notifies each
+     * changed Property once with its final value.
+     *
+     * Updates may be nested, only the outermost one notifies.
+     */
+    class PropertyUpdate final {
+    public:
+
+        PropertyUpdate() {
+            ++detail::propertyUpdateDepth();
         }
 
         /**
-         * Calls function(s) of the connected Slot(s).
-         * @param args Arguments to pass to the Slot functions.
+         * Commits the update unless already committed. A Slot throwing from this commit calls
+         * std::terminate, so commit() explicitly where Slots may throw.
          */
-        void emit(Args... args) {
-            for (auto *slot : slots) {
-                slot->callback(std::forward<Args>(args)...);
-            }
+        ~PropertyUpdate() {
+            commit();
         }
 
+        PropertyUpdate(const PropertyUpdate &) = delete;
+
+        PropertyUpdate &operator=(const PropertyUpdate &) = delete;
+
         /**
-         * Connects this Signal to the provided Slot unless already connected.
-         *
-         * @param slot Slot to connect this Signal to.
+         * Ends the update and, if it is the outermost one, notifies each Property that changed. If
+         * a Slot throws, the Properties not yet notified are notified by the next outermost commit
+         * on this thread.
          */
-        void connect(const Slot<Args...> &slot) {
-            if (!isConnectedTo(slot)) {
-                slots.push_back(&slot);
-                slot.addSignal(*this);
+        void commit() {
+            if (committed) {
+                return;
             }
+            committed = true;
+            detail::propertyUpdates().close(detail::propertyUpdateDepth());
         }
 
+    private:
+
+        bool committed = false;
+    };
+
+    /**
+     * Value that emits its changed Signal when set to a value that is not equal to the current one.
+     *
+     * Equality defaults to ==. For large values a cheaper equality can be provided, for example
+     * comparing a version number or a cached hash with byKey(). Within a PropertyUpdate the
+     * notification is deferred until it commits.
+     *
+     * A Property must only be set from one thread at a time.
+     */
+    template<typename P, typename T>
+    class BasicProperty final {
+    public:
+
+        using Equal = std::function<bool(const T &, const T &)>;
+
         /**
-         * Disconnects this Signal from the provided Slot if connected.
+         * Creates a Property comparing values with ==.
          *
-         * @param slot Slot to disconnect this Signal from.
+         * @param value Initial value.
          */
-        void disconnect(const Slot<Args...> &slot) {
-            this->removeSlot(slot);
-            slot.removeSignal(*this);
-        }
+        explicit BasicProperty(T value = T())
+                : BasicProperty(std::move(value), std::equal_to<T>()) {}
 
         /**
-         * Disconnects this Signal from all connected Slot.
+         * Creates a Property comparing values with the provided equality.
+         *
+         * @param value Initial value.
+         * @param equal Function returning true if two values are equal.
          */
-        void disconnectAll() {
-            for (auto *slot : slots) {
-                slot->removeSignal(*this);
+        BasicProperty(T value, Equal equal)
+                : value(std::move(value)), equal(std::move(equal)) {}
+
+        ~BasicProperty() {
+            if (deferred) {
+                detail::propertyUpdates().forget(this);
             }
-            slots.clear();
         }
 
+        BasicProperty(const BasicProperty &) = delete;
+
+        BasicProperty &operator=(const BasicProperty &) = delete;
+
         /**
-         * Returns the number of connections for this Signal.
+         * Returns an equality that compares the keys of two values, such as a version number.
          *
-         * @return Number of connections for this Signal.
+         * @param key Function returning the key of a value.
+         * @return Equality comparing keys with ==.
          */
-        int connectionCount() const {
-            return slots.size();
+        template<typename F>
+        static Equal byKey(F key) {
+            return [key](const T &a, const T &b) { return key(a) == key(b); };
         }
 
         /**
-         * Returns true if this Signal is connected to the provided Slot.
+         * Sets the value and, unless it is equal to the current value, emits changed.
          *
-         * @param slot Slot to test connection against.
-         * @return true if connected.
+         * @param value New value.
+         * @return true if the value changed.
+         */
+        bool set(Parameter<T> value) {
+            if (equal(this->value, value)) {
+                return false;
+            }
+            this->value = value;
+            if (detail::propertyUpdateDepth() == 0) {
+                notify();
+            } else if (!deferred) {
+                deferred = true;
+                detail::propertyUpdates().recorded.push_back({&BasicProperty::flushDeferred, this});
+            }
+            return true;
+        }
+
+        /**
+         * @return Current value.
          */
-        bool isConnectedTo(const Slot<Args...> &slot) const {
-            return std::find(slots.begin(), slots.end(), &slot) != slots.end();
+        const T &get() const {
+            return value;
         }
 
+        /**
+         * Emitted with the new value when it changes.
+         */
+        BasicSignal<P, T> changed;
+
     private:
 
-        void removeSlot(const Slot<Args...> &slot) {
-            slots.erase(std::remove(slots.begin(), slots.end(), &slot), slots.end());
+        void notify() {
+            changed.emit(value);
         }
 
-        void copyConnectionsFrom(const Signal<Args...> &other) {
-            for (auto *slot : other.slots) {
-                this->connect(*slot);
-            }
+        static void flushDeferred(void *target) {
+            auto &property = *static_cast<BasicProperty *>(target);
+            property.deferred = false;
+            property.notify();
         }
 
     private:
 
-        std::vector<const Slot<Args...> *> slots;
+        T value;
+
+        Equal equal;
+
+        bool deferred = false;
 
     };
 
-}
\ No newline at end of file
+    /**
+     * Property using the default policy.
+     */
+    template<typename T>
+    using Property = BasicProperty<DefaultPolicy, T>;
+
+}
@@ -0,0 +1,219 @@
+/**
+ * Multi-threaded contention benchmark.
+ *
+ * Runs emitter threads and connect/disconnect churner threads against shared Signals for each
+ * locking strategy and emitter count, writing throughput and emit latency percentiles as CSV.
+ *
+ * Usage: ass_contention [max emitters] [churners] [duration ms] [output.csv]
+ */
+
+#include "../ass.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ass;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    const int signalCount = 8;
+    const int slotsPerSignal = 16;
+
+    thread_local std::uint64_t delivered = 0;
+
+    /**
+     * A Signal that is shared between threads by holding an external lock around every call.
+     */
+    template<typename Lock>
+    class ExternallyLocked {
+    public:
+
+        using SlotType = Slot<int>;
+
+        void emit(int value) {
+            std::lock_guard<Lock> guard(lock);
+            signal.emit(value);
+        }
+
+        void connect(const Slot<int> &slot) {
+            std::lock_guard<Lock> guard(lock);
+            signal.connect(slot);
+        }
+
+        void disconnect(const Slot<int> &slot) {
+            std::lock_guard<Lock> guard(lock);
+            signal.disconnect(slot);
+        }
+
+    private:
+
+        Lock lock;
+        Signal<int> signal;
+    };
+
+    /**
+     * A Signal that is shared between threads using its own locking policy.
+     */
+    template<typename P>
+    class InternallyLocked {
+    public:
+
+        using SlotType = BasicSlot<P, int>;
+
+        void emit(int value) {
+            signal.emit(value);
+        }
+
+        void connect(const SlotType &slot) {
+            signal.connect(slot);
+        }
+
+        void disconnect(const SlotType &slot) {
+            signal.disconnect(slot);
+        }
+
+    private:
+
+        BasicSignal<P, int> signal;
+    };
+
+    struct Result {
+        std::uint64_t emits = 0;
+        std::uint64_t churns = 0;
+        double seconds = 0;
+        std::vector<std::uint32_t> latencies;
+    };
+
+    std::uint32_t percentile(std::vector<std::uint32_t> &sorted, double p) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        auto index = static_cast<std::size_t>(p * (sorted.size() - 1));
+        return sorted[index];
+    }
+
+    template<typename Shared>
+    Result run(int emitters, int churners, std::chrono::milliseconds duration) {
+        std::vector<Shared> signals(signalCount);
+        using SlotType = typename Shared::SlotType;
+        std::vector<std::unique_ptr<SlotType>> slots;
+
+        for (auto &signal : signals) {
+            for (int i = 0; i < slotsPerSignal; i++) {
+                slots.emplace_back(new SlotType([](int) { ++delivered; }));
+                signal.connect(*slots.back());
+            }
+        }
+
+        std::atomic<bool> start{false};
+        std::atomic<bool> stop{false};
+        std::vector<Result> results(emitters + churners);
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < emitters; t++) {
+            threads.emplace_back([&, t]() {
+                auto &result = results[t];
+                result.latencies.reserve(1 << 20);
+                while (!start) {}
+                for (std::uint64_t i = 0; !stop; i++) {
+                    auto begin = Clock::now();
+                    signals[(t + i) % signalCount].emit(static_cast<int>(i));
+                    auto end = Clock::now();
+                    if (result.latencies.size() < result.latencies.capacity()) {
+                        result.latencies.push_back(static_cast<std::uint32_t>(
+                                std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+                    }
+                    ++result.emits;
+                }
+            });
+        }
+
+        for (int t = 0; t < churners; t++) {
+            threads.emplace_back([&, t]() {
+                auto &result = results[emitters + t];
+                std::minstd_rand random(t);
+                SlotType slot([](int) { ++delivered; });
+                while (!start) {}
+                while (!stop) {
+                    auto &signal = signals[random() % signalCount];
+                    signal.connect(slot);
+                    signal.disconnect(slot);
+                    ++result.churns;
+                }
+            });
+        }
+
+        auto begin = Clock::now();
+        start = true;
+        std::this_thread::sleep_for(duration);
+        stop = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        auto seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+        Result total;
+        total.seconds = seconds;
+        for (auto &result : results) {
+            total.emits += result.emits;
+            total.churns += result.churns;
+            total.latencies.insert(total.latencies.end(), result.latencies.begin(), result.latencies.end());
+        }
+        std::sort(total.latencies.begin(), total.latencies.end());
+        return total;
+    }
+
+    template<typename Shared>
+    void benchmark(std::ostream &csv, const std::string &strategy, int maxEmitters, int churners,
+                   std::chrono::milliseconds duration) {
+        for (int emitters = 1; emitters <= maxEmitters; emitters *= 2) {
+            auto result = run<Shared>(emitters, churners, duration);
+            csv << strategy << ','
+                << emitters << ','
+                << churners << ','
+                << result.emits << ','
+                << static_cast<std::uint64_t>(result.emits / result.seconds) << ','
+                << static_cast<std::uint64_t>(result.churns / result.seconds) << ','
+                << percentile(result.latencies, 0.5) << ','
+                << percentile(result.latencies, 0.99) << ','
+                << percentile(result.latencies, 0.999) << std::endl;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int hardware = std::max(1u, std::thread::hardware_concurrency());
+    int maxEmitters = argc > 1 ? std::atoi(argv[1]) : hardware;
+    int churners = argc > 2 ? std::atoi(argv[2]) : 1;
+    auto duration = std::chrono::milliseconds(argc > 3 ? std::atoi(argv[3]) : 500);
+
+    std::ofstream file;
+    if (argc > 4) {
+        file.open(argv[4]);
+    }
+    std::ostream &csv = file.is_open() ? file : std::cout;
+
+    csv << "strategy,emitters,churners,emits,emits_per_sec,churns_per_sec,p50_ns,p99_ns,p999_ns" << std::endl;
+
+    benchmark<ExternallyLocked<std::mutex>>(csv, "external-mutex", maxEmitters, churners, duration);
+    benchmark<ExternallyLocked<SpinLock>>(csv, "external-spinlock", maxEmitters, churners, duration);
+    benchmark<InternallyLocked<Policy<MutexLocking>>>(csv, "mutex", maxEmitters, churners, duration);
+    benchmark<InternallyLocked<Policy<SpinLocking>>>(csv, "spinlock", maxEmitters, churners, duration);
+    benchmark<InternallyLocked<Policy<SpinLocking, SmallVectorStorage<32>>>>(
+            csv, "spinlock-small-vector", maxEmitters, churners, duration);
+
+    return 0;
+}
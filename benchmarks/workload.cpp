@@ -0,0 +1,236 @@
+/**
+ * Production topology workload generator.
+ *
+ * Builds a Signal/Slot graph with power-law fan-out and fan-in, then replays a trace of emits and
+ * connect/disconnect churn against it, reporting build time, throughput and memory usage.
+ *
+ * Usage: ass_workload [--option=value ...]
+ *
+ *   --signals=N          number of Signals (default 100000)
+ *   --slots=N            number of Slots (default 100000)
+ *   --max-fan-out=N      fan-out of the most connected Signal (default 10000)
+ *   --fan-out-exponent=X power-law exponent of Signal fan-out by rank (default 1.5)
+ *   --fan-in-exponent=X  Zipf exponent used to pick the Slots a Signal connects to (default 1.0)
+ *   --emit-exponent=X    Zipf exponent used to pick the Signal emitted by the trace (default 1.0)
+ *   --churn-rate=X       fraction of trace operations that reconnect a Slot (default 0.1)
+ *   --payload-bytes=N    size of the payload passed to every emit (default 64)
+ *   --operations=N       length of the generated trace (default 1000000)
+ *   --seed=N             random seed (default 1)
+ *   --trace=FILE         replay FILE instead of generating a trace, one "e <signal>" or
+ *                        "c <signal> <slot>" operation per line
+ */
+
+#include "../ass.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ass;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        std::size_t signals = 100000;
+        std::size_t slots = 100000;
+        std::size_t maxFanOut = 10000;
+        double fanOutExponent = 1.5;
+        double fanInExponent = 1.0;
+        double emitExponent = 1.0;
+        double churnRate = 0.1;
+        std::size_t payloadBytes = 64;
+        std::size_t operations = 1000000;
+        unsigned seed = 1;
+        std::string trace;
+    };
+
+    struct Operation {
+        enum Type { Emit, Churn } type;
+        std::uint32_t signal;
+        std::uint32_t slot;
+    };
+
+    /**
+     * Samples ranks 0..n-1 with probability proportional to 1 / (rank + 1)^exponent.
+     */
+    class ZipfDistribution {
+    public:
+
+        ZipfDistribution(std::size_t n, double exponent) : cdf(n) {
+            double sum = 0;
+            for (std::size_t i = 0; i < n; i++) {
+                sum += 1.0 / std::pow(i + 1.0, exponent);
+                cdf[i] = sum;
+            }
+            for (auto &value : cdf) {
+                value /= sum;
+            }
+        }
+
+        template<typename Random>
+        std::uint32_t operator()(Random &random) {
+            auto u = std::uniform_real_distribution<double>(0, 1)(random);
+            auto it = std::lower_bound(cdf.begin(), cdf.end(), u);
+            return static_cast<std::uint32_t>(std::min<std::size_t>(it - cdf.begin(), cdf.size() - 1));
+        }
+
+    private:
+
+        std::vector<double> cdf;
+    };
+
+    Config parse(int argc, char *argv[]) {
+        Config config;
+        for (int i = 1; i < argc; i++) {
+            std::string arg(argv[i]);
+            auto equals = arg.find('=');
+            auto name = arg.substr(0, equals);
+            auto value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+            if (name == "--signals") config.signals = std::stoul(value);
+            else if (name == "--slots") config.slots = std::stoul(value);
+            else if (name == "--max-fan-out") config.maxFanOut = std::stoul(value);
+            else if (name == "--fan-out-exponent") config.fanOutExponent = std::stod(value);
+            else if (name == "--fan-in-exponent") config.fanInExponent = std::stod(value);
+            else if (name == "--emit-exponent") config.emitExponent = std::stod(value);
+            else if (name == "--churn-rate") config.churnRate = std::stod(value);
+            else if (name == "--payload-bytes") config.payloadBytes = std::stoul(value);
+            else if (name == "--operations") config.operations = std::stoul(value);
+            else if (name == "--seed") config.seed = static_cast<unsigned>(std::stoul(value));
+            else if (name == "--trace") config.trace = value;
+            else {
+                std::cerr << "unknown option " << arg << std::endl;
+                std::exit(1);
+            }
+        }
+        return config;
+    }
+
+    std::vector<Operation> generateTrace(const Config &config, std::mt19937 &random) {
+        ZipfDistribution emitted(config.signals, config.emitExponent);
+        ZipfDistribution connected(config.slots, config.fanInExponent);
+        std::bernoulli_distribution churn(config.churnRate);
+
+        std::vector<Operation> trace;
+        trace.reserve(config.operations);
+        for (std::size_t i = 0; i < config.operations; i++) {
+            if (churn(random)) {
+                trace.push_back({Operation::Churn, emitted(random), connected(random)});
+            } else {
+                trace.push_back({Operation::Emit, emitted(random), 0});
+            }
+        }
+        return trace;
+    }
+
+    std::vector<Operation> loadTrace(const Config &config) {
+        std::ifstream file(config.trace);
+        if (!file) {
+            std::cerr << "cannot open trace " << config.trace << std::endl;
+            std::exit(1);
+        }
+        std::vector<Operation> trace;
+        char type;
+        std::uint32_t signal;
+        while (file >> type >> signal) {
+            std::uint32_t slot = 0;
+            if (type == 'c') {
+                file >> slot;
+            }
+            trace.push_back({type == 'c' ? Operation::Churn : Operation::Emit,
+                             static_cast<std::uint32_t>(signal % config.signals),
+                             static_cast<std::uint32_t>(slot % config.slots)});
+        }
+        return trace;
+    }
+
+    double secondsSince(Clock::time_point begin) {
+        return std::chrono::duration<double>(Clock::now() - begin).count();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    auto config = parse(argc, argv);
+    std::mt19937 random(config.seed);
+
+    std::uint64_t delivered = 0;
+    std::uint64_t checksum = 0;
+
+    auto buildBegin = Clock::now();
+
+    std::vector<std::unique_ptr<Slot<const std::string &>>> slots;
+    slots.reserve(config.slots);
+    for (std::size_t i = 0; i < config.slots; i++) {
+        slots.emplace_back(new Slot<const std::string &>([&](const std::string &payload) {
+            ++delivered;
+            checksum += payload.empty() ? 0 : static_cast<unsigned char>(payload[0]);
+        }));
+    }
+
+    std::vector<Signal<const std::string &>> signals(config.signals);
+    ZipfDistribution connected(config.slots, config.fanInExponent);
+    std::size_t connections = 0;
+    for (std::size_t rank = 0; rank < config.signals; rank++) {
+        auto fanOut = static_cast<std::size_t>(
+                std::ceil(config.maxFanOut / std::pow(rank + 1.0, config.fanOutExponent)));
+        fanOut = std::min(std::max<std::size_t>(fanOut, 1), config.slots);
+        for (std::size_t i = 0; i < fanOut; i++) {
+            signals[rank].connect(*slots[connected(random)]);
+        }
+        connections += signals[rank].connectionCount();
+    }
+
+    auto buildSeconds = secondsSince(buildBegin);
+
+    auto trace = config.trace.empty() ? generateTrace(config, random) : loadTrace(config);
+    std::string payload(config.payloadBytes, 'x');
+
+    std::uint64_t emits = 0;
+    std::uint64_t churns = 0;
+    auto replayBegin = Clock::now();
+
+    for (const auto &operation : trace) {
+        auto &signal = signals[operation.signal];
+        if (operation.type == Operation::Emit) {
+            signal.emit(payload);
+            ++emits;
+        } else {
+            auto &slot = *slots[operation.slot];
+            if (signal.isConnectedTo(slot)) {
+                signal.disconnect(slot);
+            } else {
+                signal.connect(slot);
+            }
+            ++churns;
+        }
+    }
+
+    auto replaySeconds = secondsSince(replayBegin);
+    auto memory = processMemoryUsage();
+
+    std::cout << "signals," << config.signals << std::endl
+              << "slots," << config.slots << std::endl
+              << "connections," << connections << std::endl
+              << "largest_fan_out," << signals.front().connectionCount() << std::endl
+              << "build_seconds," << buildSeconds << std::endl
+              << "emits," << emits << std::endl
+              << "churns," << churns << std::endl
+              << "deliveries," << delivered << std::endl
+              << "replay_seconds," << replaySeconds << std::endl
+              << "operations_per_sec," << static_cast<std::uint64_t>(trace.size() / replaySeconds) << std::endl
+              << "deliveries_per_sec," << static_cast<std::uint64_t>(delivered / replaySeconds) << std::endl
+              << "connection_bytes," << memory.connectionBytes << std::endl
+              << "callback_bytes," << memory.callbackBytes << std::endl
+              << "checksum," << checksum << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,277 @@
+#define CATCH_CONFIG_MAIN
+
+#include "catch/catch.hpp"
+
+#include "../ass.hpp"
+
+#include <cstdlib>
+#include <new>
+
+using namespace ass;
+
+namespace {
+
+    struct Allocations {
+        int news = 0;
+        int mallocs = 0;
+    };
+
+    bool counting = false;
+    Allocations allocations;
+
+    /**
+     * Returns the allocations made by the provided function.
+     */
+    template<typename F>
+    Allocations countAllocations(F function) {
+        allocations = Allocations();
+        counting = true;
+        function();
+        counting = false;
+        return allocations;
+    }
+}
+
+void *operator new(std::size_t size) {
+    if (counting) {
+        ++allocations.news;
+    }
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#if defined(__GLIBC__)
+
+extern "C" void *__libc_malloc(std::size_t size);
+extern "C" void *__libc_calloc(std::size_t count, std::size_t size);
+extern "C" void *__libc_realloc(void *p, std::size_t size);
+
+extern "C" void *malloc(std::size_t size) {
+    if (counting) {
+        ++allocations.mallocs;
+    }
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(std::size_t count, std::size_t size) {
+    if (counting) {
+        ++allocations.mallocs;
+    }
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *p, std::size_t size) {
+    if (counting) {
+        ++allocations.mallocs;
+    }
+    return __libc_realloc(p, size);
+}
+
+#endif
+
+TEST_CASE("emit should not allocate") {
+    int called = 0;
+    Signal<int, const std::string &> signal;
+    Slot<int, const std::string &> slot1([&](int, const std::string &) { ++called; });
+    Slot<int, const std::string &> slot2([&](int, const std::string &) { ++called; });
+    std::string string("a string that is too long for the small string optimisation");
+
+    signal.connect(slot1);
+    signal.connect(slot2);
+
+    auto counted = countAllocations([&]() {
+        for (int i = 0; i < 100; i++) {
+            signal.emit(i, string);
+        }
+    });
+
+    REQUIRE(called == 200);
+    REQUIRE(counted.news == 0);
+    REQUIRE(counted.mallocs == 0);
+}
+
+TEST_CASE("emit of a Slot with a large callback should not allocate") {
+    char large[128] = {};
+    Signal<> signal;
+    Slot<> slot([large]() { (void) large; });
+
+    signal.connect(slot);
+
+    auto counted = countAllocations([&]() {
+        signal.emit();
+    });
+
+    REQUIRE(counted.news == 0);
+    REQUIRE(counted.mallocs == 0);
+}
+
+TEST_CASE("steady-state queued emit should not allocate") {
+    EventQueue queue;
+    int called = 0;
+    Signal<int, double> signal;
+    Slot<int, double> slot1(queue, [&](int, double) { ++called; });
+    Slot<int, double> slot2(queue, [&](int, double) { ++called; });
+
+    signal.connect(slot1);
+    signal.connect(slot2);
+
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 10; i++) {
+            signal.emit(i, 1.0);
+        }
+        queue.dispatch();
+    }
+
+    auto counted = countAllocations([&]() {
+        for (int i = 0; i < 100; i++) {
+            for (int j = 0; j < 10; j++) {
+                signal.emit(i, 1.0);
+            }
+            queue.dispatch();
+        }
+    });
+
+    REQUIRE(called == 2040);
+    REQUIRE(counted.news == 0);
+    REQUIRE(counted.mallocs == 0);
+}
+
+TEST_CASE("BatchingSlot should not allocate per emission") {
+    std::size_t delivered = 0;
+    Signal<int> signal;
+    BatchingSlot<int> batching(64, [&](const BatchingSlot<int>::Batch &batch) { delivered += batch.size(); });
+    signal.connect(batching.slot());
+
+    auto counted = countAllocations([&]() {
+        for (int i = 0; i < 1000; i++) {
+            signal.emit(i);
+        }
+        batching.flush();
+    });
+
+    REQUIRE(delivered == 1000);
+    REQUIRE(counted.news == 0);
+    REQUIRE(counted.mallocs == 0);
+}
+
+TEST_CASE("connect and disconnect should not allocate within reserved capacity") {
+    Signal<> signal;
+    Slot<> slot1([]() {});
+    Slot<> slot2([]() {});
+
+    signal.reserve(2);
+    slot1.reserve(1);
+    slot2.reserve(1);
+
+    auto counted = countAllocations([&]() {
+        for (int i = 0; i < 100; i++) {
+            signal.connect(slot1);
+            signal.connect(slot2);
+            signal.disconnect(slot1);
+            signal.disconnectAll();
+        }
+    });
+
+    REQUIRE(counted.news == 0);
+    REQUIRE(counted.mallocs == 0);
+}
+
+TEST_CASE("connect and disconnect should not allocate within inline capacity") {
+    using InlinePolicy = Policy<NoLocking, SmallVectorStorage<2>>;
+
+    auto counted = countAllocations([&]() {
+        BasicSignal<InlinePolicy> signal;
+        BasicSlot<InlinePolicy> slot1([]() {});
+        BasicSlot<InlinePolicy> slot2([]() {});
+
+        for (int i = 0; i < 100; i++) {
+            signal.connect(slot1);
+            signal.connect(slot2);
+            signal.emit();
+            signal.disconnect(slot1);
+            signal.disconnectAll();
+        }
+    });
+
+    REQUIRE(counted.news == 0);
+    REQUIRE(counted.mallocs == 0);
+}
+
+TEST_CASE("Slot copy and move should make a known number of allocations") {
+    Signal<> signal;
+    Slot<> slot([]() {});
+
+    signal.reserve(4);
+    signal.connect(slot);
+
+    SECTION("copy construction allocates the connection list") {
+        auto counted = countAllocations([&]() {
+            Slot<> copy(slot);
+        });
+
+        REQUIRE(counted.news == 1);
+    }
+
+    SECTION("copy construction of a large callback also allocates the callback") {
+        char large[128] = {};
+        Slot<> largeSlot([large]() { (void) large; });
+        signal.connect(largeSlot);
+
+        auto counted = countAllocations([&]() {
+            Slot<> copy(largeSlot);
+        });
+
+        REQUIRE(counted.news == 2);
+    }
+
+    SECTION("move construction allocates the connection list") {
+        auto counted = countAllocations([&]() {
+            Slot<> moved(std::move(slot));
+        });
+
+        REQUIRE(counted.news == 1);
+    }
+
+    SECTION("move assignment within reserved capacity does not allocate") {
+        Slot<> moved([]() {});
+        moved.reserve(1);
+
+        auto counted = countAllocations([&]() {
+            moved = std::move(slot);
+        });
+
+        REQUIRE(counted.news == 0);
+    }
+}
+
+TEST_CASE("one-shot connection expiry should not allocate") {
+    int called = 0;
+    Signal<> signal;
+    Slot<> always([]() {});
+    Slot<> once([&]() { ++called; });
+    signal.connect(always);
+    signal.connectOnce(once);
+    signal.emit();
+
+    auto counted = countAllocations([&]() {
+        for (int i = 0; i < 100; i++) {
+            signal.connectOnce(once);
+            signal.emit();
+            signal.emit();
+        }
+    });
+
+    REQUIRE(called == 101);
+    REQUIRE(counted.news == 0);
+    REQUIRE(counted.mallocs == 0);
+}
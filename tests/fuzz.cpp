@@ -0,0 +1,401 @@
+/**
+ * Randomized operation fuzzer.
+ *
+ * Interprets the input as a sequence of connect, one-shot and N-shot connect, sample, disconnect,
+ * copy, move, destroy and emit operations on a small pool of Signals and Slots. After every operation
+ * the connections reported by both sides and the suppressed deliveries of each connection are checked
+ * against a model, and the allocations and callback invocations of the operation are checked against
+ * its expected complexity. Each input is run against the default policy and against a
+ * locking, small vector storage, priority ordered policy.
+ *
+ * Built with -DASS_LIBFUZZER=ON this is a libFuzzer target, otherwise it is a standalone executable
+ * that runs random inputs: ass_fuzz [iterations] [seed]
+ */
+
+#include "../ass.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace ass;
+
+namespace {
+
+    const int poolSize = 6;
+
+    int allocations = 0;
+    int invocations = 0;
+
+    /**
+     * Model of the delivery filter of a connection: its sampling and remaining deliveries.
+     */
+    struct Filter {
+        std::uint64_t every = 1;
+        std::uint64_t sampled = 0;
+        std::size_t suppressed = 0;
+        std::uint64_t shots = 0;
+    };
+
+    template<typename P>
+    struct Pool {
+        using SignalType = BasicSignal<P, int>;
+        using SlotType = BasicSlot<P, int>;
+
+        std::unique_ptr<SignalType> signals[poolSize];
+        std::unique_ptr<SlotType> slots[poolSize];
+        bool connected[poolSize][poolSize] = {};
+        Filter filters[poolSize][poolSize];
+        bool filtered[poolSize] = {};
+        bool callable[poolSize] = {};
+    };
+
+    enum Operation {
+        CreateSignal,
+        CreateSlot,
+        Connect,
+        ConnectOnce,
+        ConnectFor,
+        SetSampling,
+        Disconnect,
+        DisconnectAll,
+        CopySignal,
+        MoveSignal,
+        CopySlot,
+        MoveSlot,
+        DestroySignal,
+        DestroySlot,
+        Emit,
+        OperationCount
+    };
+
+    const char *operationNames[] = {
+            "create signal", "create slot", "connect", "connect once", "connect for", "set sampling", "disconnect",
+            "disconnect all", "copy signal", "move signal", "copy slot", "move slot", "destroy signal",
+            "destroy slot", "emit"
+    };
+
+    void fail(const char *message, int operation, int a, int b) {
+        std::fprintf(stderr, "%s after %s(%d, %d)\n", message, operationNames[operation], a, b);
+        std::abort();
+    }
+
+    template<typename Pool>
+    int fanOut(const Pool &pool, int signal) {
+        int count = 0;
+        for (int slot = 0; slot < poolSize; slot++) {
+            count += pool.connected[signal][slot];
+        }
+        return count;
+    }
+
+    template<typename Pool>
+    int fanIn(const Pool &pool, int slot) {
+        int count = 0;
+        for (int signal = 0; signal < poolSize; signal++) {
+            count += pool.connected[signal][slot];
+        }
+        return count;
+    }
+
+    /**
+     * Upper bound on allocations for an operation that makes the provided number of connections. Each
+     * connection may grow the connection lists of both sides.
+     */
+    int connectAllocationBound(int connections) {
+        return 2 * connections;
+    }
+
+    /**
+     * Upper bound on the further allocations for an operation that makes the provided number of
+     * connections to a Signal with delivery filters. The first filter allocates the delivery state
+     * and filter list of the Signal, and each connection may grow the filter list.
+     */
+    int filterAllocationBound(int connections) {
+        return connections + 2;
+    }
+
+    template<typename Pool>
+    void forget(Pool &pool, int signal, int slot) {
+        pool.connected[signal][slot] = false;
+        pool.filters[signal][slot] = Filter();
+    }
+
+    /**
+     * Emitting to a Slot without a callback, such as a moved from Slot, is a precondition violation.
+     */
+    template<typename Pool>
+    bool canEmit(const Pool &pool, int signal) {
+        for (int slot = 0; slot < poolSize; slot++) {
+            if (pool.connected[signal][slot] && !pool.callable[slot]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Applies the modelled filters of the connections of a Signal to an emission, disconnecting the
+     * connections that made their last delivery, and returns the number of Slots to be called.
+     */
+    template<typename Pool>
+    int admit(Pool &pool, int signal) {
+        int admitted = 0;
+        for (int slot = 0; slot < poolSize; slot++) {
+            if (!pool.connected[signal][slot]) {
+                continue;
+            }
+            auto &filter = pool.filters[signal][slot];
+            if (filter.every > 1 && filter.sampled++ % filter.every != 0) {
+                ++filter.suppressed;
+                continue;
+            }
+            ++admitted;
+            if (filter.shots != 0 && --filter.shots == 0) {
+                forget(pool, signal, slot);
+            }
+        }
+        return admitted;
+    }
+
+    template<typename SlotType>
+    SlotType *newSlot() {
+        return new SlotType([](int) { ++invocations; });
+    }
+
+    template<typename Pool>
+    void checkInvariants(const Pool &pool, int operation, int a, int b) {
+        for (int signal = 0; signal < poolSize; signal++) {
+            if (pool.signals[signal] && pool.signals[signal]->connectionCount() != fanOut(pool, signal)) {
+                fail("Signal connection count does not match model", operation, a, b);
+            }
+        }
+        for (int slot = 0; slot < poolSize; slot++) {
+            if (pool.slots[slot] && pool.slots[slot]->connectionCount() != fanIn(pool, slot)) {
+                fail("Slot connection count does not match model", operation, a, b);
+            }
+        }
+        for (int signal = 0; signal < poolSize; signal++) {
+            for (int slot = 0; slot < poolSize; slot++) {
+                if (!pool.signals[signal] || !pool.slots[slot]) {
+                    continue;
+                }
+                bool expected = pool.connected[signal][slot];
+                if (pool.signals[signal]->isConnectedTo(*pool.slots[slot]) != expected) {
+                    fail("Signal connection does not match model", operation, a, b);
+                }
+                if (pool.slots[slot]->isConnectedTo(*pool.signals[signal]) != expected) {
+                    fail("Slot connection does not match model", operation, a, b);
+                }
+                if (pool.signals[signal]->suppressedCount(*pool.slots[slot]) != pool.filters[signal][slot].suppressed) {
+                    fail("suppressed deliveries do not match model", operation, a, b);
+                }
+            }
+        }
+    }
+
+    /**
+     * Applies an operation to the pool and model, returning the upper bound on allocations it may make.
+     */
+    template<typename Pool>
+    int apply(Pool &pool, int operation, int a, int b) {
+        using SignalType = typename Pool::SignalType;
+        using SlotType = typename Pool::SlotType;
+
+        auto &signal = pool.signals[a];
+        auto &slot = pool.slots[a];
+        switch (operation) {
+            case CreateSignal:
+                if (!signal) {
+                    signal.reset(new SignalType());
+                }
+                return 1;
+            case CreateSlot:
+                if (!slot) {
+                    slot.reset(newSlot<SlotType>());
+                    pool.callable[a] = true;
+                }
+                return 1;
+            case Connect:
+                if (signal && pool.slots[b]) {
+                    signal->connect(*pool.slots[b]);
+                    pool.connected[a][b] = true;
+                }
+                return connectAllocationBound(1) + (pool.filtered[a] ? filterAllocationBound(1) : 0);
+            case ConnectOnce:
+            case ConnectFor:
+                if (signal && pool.slots[b]) {
+                    std::uint64_t count = operation == ConnectOnce ? 1 : 2 + (a + b) % 2;
+                    operation == ConnectOnce ? signal->connectOnce(*pool.slots[b]) : signal->connectFor(*pool.slots[b], count);
+                    pool.connected[a][b] = true;
+                    pool.filters[a][b].shots = count;
+                    pool.filtered[a] = true;
+                }
+                return connectAllocationBound(1) + filterAllocationBound(1);
+            case SetSampling:
+                if (signal && pool.slots[b] && pool.connected[a][b]) {
+                    std::uint64_t every = 1 + (a + b) % 3;
+                    signal->setSampling(*pool.slots[b], every);
+                    pool.filters[a][b].every = every;
+                    pool.filters[a][b].sampled = 0;
+                    pool.filtered[a] = true;
+                }
+                return filterAllocationBound(0);
+            case Disconnect:
+                if (signal && pool.slots[b]) {
+                    signal->disconnect(*pool.slots[b]);
+                    forget(pool, a, b);
+                }
+                return 0;
+            case DisconnectAll:
+                if (signal) {
+                    signal->disconnectAll();
+                    for (int i = 0; i < poolSize; i++) {
+                        forget(pool, a, i);
+                    }
+                }
+                return 0;
+            case CopySignal:
+            case MoveSignal:
+                if (a != b && pool.signals[b]) {
+                    auto &other = pool.signals[b];
+                    bool created = !signal;
+                    if (operation == CopySignal) {
+                        created ? signal.reset(new SignalType(*other)) : void(*signal = *other);
+                    } else {
+                        created ? signal.reset(new SignalType(std::move(*other))) : void(*signal = std::move(*other));
+                    }
+                    for (int i = 0; i < poolSize; i++) {
+                        pool.connected[a][i] = pool.connected[b][i];
+                        pool.filters[a][i] = pool.filters[b][i];
+                        if (operation == MoveSignal) {
+                            forget(pool, b, i);
+                        }
+                    }
+                    pool.filtered[a] = pool.filtered[a] || pool.filtered[b];
+                    return created + connectAllocationBound(fanOut(pool, a)) +
+                           (pool.filtered[a] ? filterAllocationBound(fanOut(pool, a)) : 0);
+                }
+                return 0;
+            case CopySlot:
+            case MoveSlot:
+                if (a != b && pool.slots[b]) {
+                    auto &other = pool.slots[b];
+                    bool created = !slot;
+                    if (operation == CopySlot) {
+                        created ? slot.reset(new SlotType(*other)) : void(*slot = *other);
+                    } else {
+                        created ? slot.reset(new SlotType(std::move(*other))) : void(*slot = std::move(*other));
+                    }
+                    int filteredFanIn = 0;
+                    for (int i = 0; i < poolSize; i++) {
+                        pool.connected[i][a] = pool.connected[i][b];
+                        pool.filters[i][a] = pool.filters[i][b];
+                        filteredFanIn += pool.connected[i][a] && pool.filtered[i];
+                        if (operation == MoveSlot) {
+                            forget(pool, i, b);
+                        }
+                    }
+                    bool callable = pool.callable[a];
+                    pool.callable[a] = pool.callable[b];
+                    if (operation == MoveSlot) {
+                        pool.callable[b] = !created && callable;
+                    }
+                    return created + connectAllocationBound(fanIn(pool, a)) + filteredFanIn;
+                }
+                return 0;
+            case DestroySignal:
+                signal.reset();
+                pool.filtered[a] = false;
+                for (int i = 0; i < poolSize; i++) {
+                    forget(pool, a, i);
+                }
+                return 0;
+            case DestroySlot:
+                slot.reset();
+                pool.callable[a] = false;
+                for (int i = 0; i < poolSize; i++) {
+                    forget(pool, i, a);
+                }
+                return 0;
+            case Emit:
+                if (signal && canEmit(pool, a)) {
+                    invocations = 0;
+                    signal->emit(b);
+                    if (invocations != admit(pool, a)) {
+                        fail("emit did not call each admitted Slot once", operation, a, b);
+                    }
+                }
+                return 0;
+            default:
+                return 0;
+        }
+    }
+
+    template<typename P>
+    void run(const std::uint8_t *data, std::size_t size) {
+        Pool<P> pool;
+        for (std::size_t i = 0; i + 2 < size; i += 3) {
+            int operation = data[i] % OperationCount;
+            int a = data[i + 1] % poolSize;
+            int b = data[i + 2] % poolSize;
+
+            allocations = 0;
+            int bound = apply(pool, operation, a, b);
+            if (allocations > bound) {
+                fail("operation allocated more than its complexity bound", operation, a, b);
+            }
+
+            checkInvariants(pool, operation, a, b);
+        }
+    }
+}
+
+void *operator new(std::size_t size) {
+    ++allocations;
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t *data, std::size_t size) {
+    run<DefaultPolicy>(data, size);
+    run<Policy<MutexLocking, SmallVectorStorage<2>, PriorityOrder>>(data, size);
+    return 0;
+}
+
+#if !defined(ASS_LIBFUZZER)
+
+int main(int argc, char *argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 10000;
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : std::random_device()();
+
+    std::printf("fuzzing %d inputs with seed %u\n", iterations, seed);
+
+    std::mt19937 random(seed);
+    std::vector<std::uint8_t> input;
+    for (int i = 0; i < iterations; i++) {
+        input.resize(random() % 1024);
+        for (auto &byte : input) {
+            byte = static_cast<std::uint8_t>(random());
+        }
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+
+    return 0;
+}
+
+#endif
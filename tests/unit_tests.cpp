@@ -4,6 +4,13 @@
 
 #include "../ass.hpp"
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
 using namespace ass;
 
 class CountingCallable {
@@ -914,3 +921,1760 @@ TEST_CASE("Slot can callback on a class function") {
 
     REQUIRE(count == 5);
 }
+
+TEST_CASE("Signal should report memory held by its connections") {
+    Signal<> signal;
+    Slot<> slot1([]() {});
+    Slot<> slot2([]() {});
+
+    signal.reserve(4);
+    signal.connect(slot1);
+    signal.connect(slot2);
+
+    SECTION("connection bytes should cover each connection") {
+        REQUIRE(signal.memoryUsage().connectionBytes == 2 * sizeof(void *));
+    }
+
+    SECTION("slack bytes should cover unused capacity") {
+        REQUIRE(signal.memoryUsage().slackBytes == 2 * sizeof(void *));
+    }
+
+    SECTION("shrinkToFit should release unused capacity") {
+        signal.disconnect(slot2);
+        signal.shrinkToFit();
+
+        REQUIRE(signal.memoryUsage().connectionBytes == sizeof(void *));
+        REQUIRE(signal.memoryUsage().slackBytes == 0);
+        REQUIRE(signal.isConnectedTo(slot1));
+    }
+
+    SECTION("state bytes should cover delivery filters and buffered emissions") {
+        REQUIRE(signal.memoryUsage().stateBytes == 0);
+
+        signal.setSampling(slot1, 2);
+        signal.pause();
+        for (int i = 0; i < 64; i++) {
+            signal.emit();
+        }
+        auto paused = signal.memoryUsage().stateBytes;
+        signal.resume();
+        signal.shrinkToFit();
+
+        REQUIRE(paused > 0);
+        REQUIRE(signal.memoryUsage().stateBytes > 0);
+        REQUIRE(signal.memoryUsage().stateBytes < paused);
+    }
+}
+
+TEST_CASE("Slot should report memory held by its connections and callback") {
+    SECTION("small callback should not report callback bytes") {
+        Slot<> slot([]() {});
+
+        REQUIRE(slot.memoryUsage().callbackBytes == 0);
+    }
+
+    SECTION("large callback should report callback bytes") {
+        char large[128] = {};
+        Slot<> slot([large]() { (void) large; });
+
+        REQUIRE(slot.memoryUsage().callbackBytes >= sizeof(large));
+    }
+
+    SECTION("Slot bound to an Executor should report state bytes") {
+        EventQueue queue;
+        Slot<> unbound([]() {});
+        Slot<> bound(queue, []() {});
+
+        REQUIRE(unbound.memoryUsage().stateBytes == 0);
+        REQUIRE(bound.memoryUsage().stateBytes > 0);
+    }
+
+    SECTION("shrinkToFit should release unused capacity") {
+        Signal<> signal1;
+        Signal<> signal2;
+        Slot<> slot([]() {});
+
+        signal1.connect(slot);
+        signal2.connect(slot);
+        signal2.disconnect(slot);
+        slot.shrinkToFit();
+
+        REQUIRE(slot.memoryUsage().connectionBytes == sizeof(void *));
+        REQUIRE(slot.memoryUsage().slackBytes == 0);
+    }
+}
+
+TEST_CASE("process memory usage should track Signals and Slots") {
+    auto before = processMemoryUsage();
+
+    {
+        char large[128] = {};
+        Slot<> slot([large]() { (void) large; });
+        Signal<> signal;
+        signal.connect(slot);
+
+        auto during = processMemoryUsage();
+
+        REQUIRE(during.connectionBytes >= before.connectionBytes + 2 * sizeof(void *));
+        REQUIRE(during.callbackBytes >= before.callbackBytes + sizeof(large));
+    }
+
+    auto after = processMemoryUsage();
+
+    REQUIRE(after.connectionBytes == before.connectionBytes);
+    REQUIRE(after.callbackBytes == before.callbackBytes);
+}
+
+TEST_CASE("Signal with priority order should call higher priority Slots first") {
+    using PriorityPolicy = Policy<NoLocking, VectorStorage, PriorityOrder>;
+
+    std::vector<int> calls;
+    BasicSignal<PriorityPolicy> signal;
+    BasicSlot<PriorityPolicy> low([&]() { calls.push_back(1); });
+    BasicSlot<PriorityPolicy> middle([&]() { calls.push_back(2); });
+    BasicSlot<PriorityPolicy> high([&]() { calls.push_back(3); });
+    BasicSlot<PriorityPolicy> alsoMiddle([&]() { calls.push_back(4); });
+
+    signal.connect(low, -1);
+    signal.connect(middle);
+    signal.connect(high, 10);
+    signal.connect(alsoMiddle);
+
+    SECTION("Slots of equal priority should be called in connection order") {
+        signal.emit();
+
+        REQUIRE(calls == std::vector<int>{3, 2, 4, 1});
+    }
+
+    SECTION("copied Slot should keep the priority of the original") {
+        BasicSlot<PriorityPolicy> copy(high);
+        signal.disconnect(high);
+        signal.emit();
+
+        REQUIRE(calls == std::vector<int>{3, 2, 4, 1});
+    }
+}
+
+TEST_CASE("Signal with small vector storage should connect beyond its inline capacity") {
+    using SmallPolicy = Policy<NoLocking, SmallVectorStorage<2>>;
+
+    int called = 0;
+    BasicSignal<SmallPolicy> signal;
+    std::vector<std::unique_ptr<BasicSlot<SmallPolicy>>> slots;
+
+    for (int i = 0; i < 5; i++) {
+        slots.emplace_back(new BasicSlot<SmallPolicy>([&]() { ++called; }));
+        signal.connect(*slots.back());
+    }
+
+    SECTION("all Slots should be connected and called") {
+        signal.emit();
+
+        REQUIRE(signal.connectionCount() == 5);
+        REQUIRE(called == 5);
+    }
+
+    SECTION("shrinkToFit should return to inline storage") {
+        slots.resize(1);
+        signal.shrinkToFit();
+
+        REQUIRE(signal.connectionCount() == 1);
+        REQUIRE(signal.memoryUsage().slackBytes == sizeof(void *));
+    }
+}
+
+TEST_CASE("Signal with mutex locking can be shared between threads") {
+    using ThreadedPolicy = Policy<MutexLocking>;
+
+    std::atomic<int> called{0};
+    BasicSignal<ThreadedPolicy> signal;
+    BasicSlot<ThreadedPolicy> shared([&]() { ++called; });
+    signal.connect(shared);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 1000; i++) {
+                BasicSlot<ThreadedPolicy> slot([]() {});
+                signal.connect(slot);
+                signal.emit();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(called == 4000);
+    REQUIRE(signal.connectionCount() == 1);
+}
+
+TEST_CASE("Signal and Slot with mutex locking can be copied concurrently") {
+    using ThreadedPolicy = Policy<MutexLocking>;
+
+    BasicSignal<ThreadedPolicy> signal;
+    BasicSlot<ThreadedPolicy> slot([]() {});
+    signal.connect(slot);
+
+    std::thread copyingSignal([&]() {
+        for (int i = 0; i < 1000; i++) {
+            BasicSignal<ThreadedPolicy> copy(signal);
+        }
+    });
+    std::thread copyingSlot([&]() {
+        for (int i = 0; i < 1000; i++) {
+            BasicSlot<ThreadedPolicy> copy(slot);
+        }
+    });
+    copyingSignal.join();
+    copyingSlot.join();
+
+    REQUIRE(signal.connectionCount() == 1);
+    REQUIRE(slot.connectionCount() == 1);
+}
+
+TEST_CASE("Slot copied while its Signal emits should always have its function") {
+    using ThreadedPolicy = Policy<MutexLocking>;
+
+    std::atomic<int> called{0};
+    std::atomic<bool> done{false};
+    std::atomic<int> failed{0};
+    BasicSignal<ThreadedPolicy> signal;
+    BasicSlot<ThreadedPolicy> slot([&]() { ++called; });
+    signal.connect(slot);
+
+    std::thread emitter([&]() {
+        while (!done) {
+            try {
+                signal.emit();
+            } catch (const std::bad_function_call &) {
+                ++failed;
+            }
+        }
+    });
+    for (int i = 0; i < 2000; i++) {
+        BasicSlot<ThreadedPolicy> copy(slot);
+    }
+    done = true;
+    emitter.join();
+
+    REQUIRE(failed == 0);
+    REQUIRE(signal.connectionCount() == 1);
+}
+
+TEST_CASE("arguments should be passed by value or const reference by type") {
+    struct Big {
+        char data[64];
+    };
+
+    STATIC_REQUIRE(std::is_same<Parameter<int>, int>::value);
+    STATIC_REQUIRE(std::is_same<Parameter<double>, double>::value);
+    STATIC_REQUIRE(std::is_same<Parameter<Big>, const Big &>::value);
+    STATIC_REQUIRE(std::is_same<Parameter<std::string>, const std::string &>::value);
+    STATIC_REQUIRE(std::is_same<Parameter<const Big &>, const Big &>::value);
+    STATIC_REQUIRE(std::is_same<Parameter<int &>, int &>::value);
+    STATIC_REQUIRE(std::is_same<Owned<const Big &>, Big>::value);
+    STATIC_REQUIRE(std::is_same<Owned<std::string>, std::string>::value);
+}
+
+TEST_CASE("Signal with rvalue reference arguments should let the Slot move from them") {
+    std::string received;
+    Signal<std::string &&> signal;
+    Slot<std::string &&> slot([&](std::string &&value) { received = std::move(value); });
+    signal.connect(slot);
+
+    std::string sent = "moved";
+    signal.emit(std::move(sent));
+
+    REQUIRE(received == "moved");
+
+    SECTION("held emissions should be passed as rvalues on resume") {
+        signal.pause();
+        signal.emit(std::string("held"));
+        signal.resume();
+
+        REQUIRE(received == "held");
+    }
+
+    SECTION("queued Slots should each move from their own copy") {
+        EventQueue queue;
+        std::string first;
+        std::string second;
+        Slot<std::string &&> queued1(queue, [&](std::string &&value) { first = std::move(value); });
+        Slot<std::string &&> queued2(queue, [&](std::string &&value) { second = std::move(value); });
+        signal.disconnect(slot);
+        signal.connect(queued1);
+        signal.connect(queued2);
+        signal.emit(std::string("queued"));
+        queue.dispatch();
+
+        REQUIRE(first == "queued");
+        REQUIRE(second == "queued");
+    }
+
+    SECTION("Slots of a frame should each move from their own copy") {
+        FrameDispatcher frame;
+        std::string other;
+        Slot<std::string &&> second([&](std::string &&value) { other = std::move(value); });
+        signal.connect(second);
+        signal.setDispatcher(&frame);
+        signal.emit(std::string("framed"));
+        frame.dispatch();
+
+        REQUIRE(received == "framed");
+        REQUIRE(other == "framed");
+        signal.setDispatcher(nullptr);
+    }
+}
+
+TEST_CASE("Signal should not copy arguments for each Slot") {
+    struct CopyCounter {
+        int *copies;
+
+        explicit CopyCounter(int *copies) : copies(copies) {}
+
+        CopyCounter(const CopyCounter &other) : copies(other.copies) { ++*copies; }
+    };
+
+    int copies = 0;
+    CopyCounter counter(&copies);
+    Signal<CopyCounter> signal;
+    Slot<CopyCounter> slot1([](const CopyCounter &) {});
+    Slot<CopyCounter> slot2([](const CopyCounter &) {});
+
+    signal.connect(slot1);
+    signal.connect(slot2);
+    signal.emit(counter);
+
+    REQUIRE(copies == 0);
+}
+
+TEST_CASE("Signal should forward the same argument to every Slot") {
+    std::vector<std::string> received;
+    Signal<std::string> signal;
+    Slot<std::string> slot1([&](std::string s) { received.push_back(std::move(s)); });
+    Slot<std::string> slot2([&](std::string s) { received.push_back(std::move(s)); });
+
+    signal.connect(slot1);
+    signal.connect(slot2);
+    signal.emit("hello");
+
+    REQUIRE(received == std::vector<std::string>{"hello", "hello"});
+}
+
+TEST_CASE("Payload should be a zero-copy view until escaped") {
+    std::string buffer("payload read from a socket");
+    Payload<char> payload(buffer.data(), buffer.size());
+    Signal<Payload<char>> signal;
+
+    SECTION("synchronous Slots should read the original buffer") {
+        const char *seen = nullptr;
+        Slot<Payload<char>> slot([&](const Payload<char> &p) { seen = p.data(); });
+
+        signal.connect(slot);
+        signal.emit(payload);
+
+        REQUIRE(seen == buffer.data());
+        REQUIRE_FALSE(payload.isOwned());
+    }
+
+    SECTION("escaping Slots should share a single copy") {
+        std::vector<Payload<char>> kept;
+        Slot<Payload<char>> slot1([&](const Payload<char> &p) { kept.push_back(p.escape()); });
+        Slot<Payload<char>> slot2([&](const Payload<char> &p) { kept.push_back(own(p)); });
+
+        signal.connect(slot1);
+        signal.connect(slot2);
+        signal.emit(payload);
+        buffer.assign(buffer.size(), 'x');
+
+        REQUIRE(kept.size() == 2);
+        REQUIRE(kept[0].isOwned());
+        REQUIRE(static_cast<const void *>(kept[0].data()) != static_cast<const void *>(buffer.data()));
+        REQUIRE(static_cast<const void *>(kept[0].data()) == static_cast<const void *>(kept[1].data()));
+        REQUIRE(std::string(kept[1].begin(), kept[1].end()) == "payload read from a socket");
+    }
+}
+
+TEST_CASE("Slot bound to an EventQueue should be called on dispatch") {
+    EventQueue queue;
+    int received = 0;
+    Signal<int> signal;
+    Slot<int> slot(queue, [&](int i) { received = i; });
+
+    signal.connect(slot);
+    signal.emit(5);
+
+    SECTION("Slot should not be called by emit") {
+        REQUIRE(received == 0);
+        REQUIRE(queue.size() == 1);
+    }
+
+    SECTION("Slot should be called by dispatch") {
+        REQUIRE(queue.dispatch() == 1);
+        REQUIRE(received == 5);
+    }
+
+    SECTION("destroyed Slot should not be called by dispatch") {
+        int destroyedReceived = 0;
+        std::unique_ptr<Slot<int>> destroyed(new Slot<int>(queue, [&](int i) { destroyedReceived = i; }));
+        signal.connect(*destroyed);
+        signal.emit(7);
+        destroyed.reset();
+
+        queue.dispatch();
+
+        REQUIRE(destroyedReceived == 0);
+        REQUIRE(received == 7);
+    }
+
+    SECTION("moved Slot should receive queued deliveries") {
+        Slot<int> moved(std::move(slot));
+
+        queue.dispatch();
+
+        REQUIRE(received == 5);
+    }
+}
+
+TEST_CASE("queued Slots should share one copy of the arguments per emit") {
+    struct CopyCounter {
+        int *copies;
+
+        explicit CopyCounter(int *copies) : copies(copies) {}
+
+        CopyCounter(const CopyCounter &other) : copies(other.copies) { ++*copies; }
+
+        CopyCounter(CopyCounter &&other) noexcept : copies(other.copies) {}
+    };
+
+    int copies = 0;
+    int called = 0;
+    EventQueue queue;
+    Signal<CopyCounter> signal;
+    Slot<CopyCounter> direct([&](const CopyCounter &) { ++called; });
+    Slot<CopyCounter> queued1(queue, [&](const CopyCounter &) { ++called; });
+    Slot<CopyCounter> queued2(queue, [&](const CopyCounter &) { ++called; });
+    Slot<CopyCounter> queued3(queue, [&](const CopyCounter &) { ++called; });
+
+    signal.connect(direct);
+    signal.connect(queued1);
+    signal.connect(queued2);
+    signal.connect(queued3);
+    signal.emit(CopyCounter(&copies));
+    queue.dispatch();
+
+    REQUIRE(called == 4);
+    REQUIRE(copies == 1);
+}
+
+TEST_CASE("queued Slot should be called on the dispatching thread") {
+    EventQueue queue;
+    std::atomic<int> received{0};
+    std::thread::id receiver;
+    Signal<int> signal;
+    Slot<int> slot(queue, [&](int i) {
+        receiver = std::this_thread::get_id();
+        received += i;
+    });
+    signal.connect(slot);
+
+    std::thread consumer([&]() {
+        while (received < 10) {
+            if (queue.wait(std::chrono::milliseconds(10))) {
+                queue.dispatch();
+            }
+        }
+    });
+    auto consumerId = consumer.get_id();
+
+    for (int i = 0; i < 10; i++) {
+        signal.emit(1);
+    }
+    consumer.join();
+
+    REQUIRE(received == 10);
+    REQUIRE(receiver == consumerId);
+}
+
+TEST_CASE("BatchingSlot should deliver accumulated emissions as a batch") {
+    std::vector<std::vector<int>> batches;
+    std::vector<const int *> buffers;
+    Signal<int> signal;
+
+    auto record = [&](const BatchingSlot<int>::Batch &batch) {
+        batches.emplace_back(batch.begin(), batch.end());
+        buffers.push_back(batch.data());
+    };
+
+    SECTION("batch should be delivered when the maximum size is reached") {
+        BatchingSlot<int> batching(3, record);
+        signal.connect(batching.slot());
+
+        for (int i = 0; i < 7; i++) {
+            signal.emit(i);
+        }
+
+        REQUIRE(batches == std::vector<std::vector<int>>{{0, 1, 2}, {3, 4, 5}});
+        REQUIRE(batching.size() == 1);
+        REQUIRE(buffers[0] == buffers[1]);
+    }
+
+    SECTION("flush should deliver a partial batch") {
+        BatchingSlot<int> batching(3, record);
+        signal.connect(batching.slot());
+
+        signal.emit(1);
+        batching.flush();
+        batching.flush();
+
+        REQUIRE(batches == std::vector<std::vector<int>>{{1}});
+    }
+
+    SECTION("destruction should deliver a partial batch") {
+        {
+            BatchingSlot<int> batching(3, record);
+            signal.connect(batching.slot());
+            signal.emit(1);
+        }
+
+        REQUIRE(batches == std::vector<std::vector<int>>{{1}});
+        REQUIRE(signal.connectionCount() == 0);
+    }
+
+    SECTION("poll should deliver a batch older than the maximum delay") {
+        BatchingSlot<int> batching(100, std::chrono::milliseconds(1), record);
+        signal.connect(batching.slot());
+
+        signal.emit(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        REQUIRE(batching.poll());
+        REQUIRE(batches == std::vector<std::vector<int>>{{1}});
+        REQUIRE_FALSE(batching.poll());
+    }
+}
+
+TEST_CASE("BatchingSlot should batch multiple arguments as tuples") {
+    std::vector<std::tuple<int, std::string>> rows;
+    Signal<int, std::string> signal;
+    BatchingSlot<int, std::string> batching(2, [&](const BatchingSlot<int, std::string>::Batch &batch) {
+        rows.insert(rows.end(), batch.begin(), batch.end());
+    });
+    signal.connect(batching.slot());
+
+    signal.emit(1, "one");
+    signal.emit(2, "two");
+
+    REQUIRE(rows == std::vector<std::tuple<int, std::string>>{std::make_tuple(1, "one"), std::make_tuple(2, "two")});
+}
+
+TEST_CASE("BatchSignal should deliver columns to batch Slots and elements to ordinary Slots") {
+    BatchSignal<int, double> signal(4);
+    std::vector<std::pair<int, double>> elements;
+    std::vector<double> sums;
+    std::vector<bool> aligned;
+
+    BatchSlot<int, double> batch([&](const Payload<int> &ids, const Payload<double> &prices) {
+        double sum = 0;
+        for (std::size_t i = 0; i < prices.size(); i++) {
+            sum += ids[i] * prices[i];
+        }
+        sums.push_back(sum);
+        aligned.push_back(reinterpret_cast<std::uintptr_t>(prices.data()) % 64 == 0);
+    });
+    Slot<int, double> element([&](int id, double price) { elements.emplace_back(id, price); });
+
+    signal.connect(batch);
+    signal.connect(element);
+
+    for (int i = 1; i <= 6; i++) {
+        signal.emit(i, 0.5);
+    }
+
+    SECTION("full batch should be delivered") {
+        REQUIRE(sums == std::vector<double>{5.0});
+        REQUIRE(elements.size() == 4);
+        REQUIRE(signal.size() == 2);
+    }
+
+    SECTION("columns should be aligned") {
+        REQUIRE(aligned == std::vector<bool>{true});
+    }
+
+    SECTION("flush should deliver a partial batch in order") {
+        signal.flush();
+
+        REQUIRE(sums == std::vector<double>{5.0, 5.5});
+        REQUIRE(elements.back() == std::make_pair(6, 0.5));
+        REQUIRE(elements.size() == 6);
+    }
+
+    SECTION("Slots should disconnect when destructed") {
+        REQUIRE(signal.connectionCount() == 2);
+        {
+            BatchSlot<int, double> temporary([](const Payload<int> &, const Payload<double> &) {});
+            signal.connect(temporary);
+            REQUIRE(signal.connectionCount() == 3);
+        }
+        REQUIRE(signal.connectionCount() == 2);
+    }
+}
+
+TEST_CASE("count Window should aggregate the most recent values") {
+    Signal<int> signal;
+    Window<int> window(4);
+    signal.connect(window.slot());
+
+    SECTION("empty Window should aggregate to zero") {
+        REQUIRE(window.count() == 0);
+        REQUIRE(window.sum() == 0);
+        REQUIRE(window.min() == 0);
+        REQUIRE(window.max() == 0);
+        REQUIRE(window.mean() == 0.0);
+    }
+
+    SECTION("Window should keep the last values across the ring buffer wrap") {
+        for (int value : {5, -3, 9, 1, 7, 2, 8, 4, 6, 3}) {
+            signal.emit(value);
+        }
+
+        REQUIRE(window.count() == 4);
+        REQUIRE(window.sum() == 8 + 4 + 6 + 3);
+        REQUIRE(window.min() == 3);
+        REQUIRE(window.max() == 8);
+        REQUIRE(window.mean() == Approx(5.25));
+    }
+
+    SECTION("readers should be notified when a value is added") {
+        std::vector<int> sums;
+        Slot<> reader1([&]() { sums.push_back(window.sum()); });
+        Slot<> reader2([&]() { sums.push_back(window.max()); });
+        window.updated.connect(reader1);
+        window.updated.connect(reader2);
+
+        signal.emit(2);
+        signal.emit(3);
+
+        REQUIRE(sums == std::vector<int>{2, 2, 5, 3});
+    }
+}
+
+TEST_CASE("large count Window should reduce every value") {
+    Signal<double> signal;
+    Window<double> window(1000);
+    signal.connect(window.slot());
+
+    for (int i = 0; i < 1500; i++) {
+        signal.emit(i);
+    }
+
+    REQUIRE(window.sum() == Approx((500.0 + 1499.0) * 1000 / 2));
+    REQUIRE(window.min() == 500.0);
+    REQUIRE(window.max() == 1499.0);
+}
+
+TEST_CASE("time Window should drop values older than its duration") {
+    Signal<int> signal;
+
+    SECTION("values within the duration should be kept") {
+        Window<int> window(std::chrono::seconds(10), 2);
+        signal.connect(window.slot());
+        signal.emit(1);
+        signal.emit(2);
+        signal.emit(3);
+
+        REQUIRE(window.count() == 3);
+        REQUIRE(window.sum() == 6);
+    }
+
+    SECTION("values older than the duration should be dropped") {
+        Window<int> window(std::chrono::milliseconds(100), 2);
+        signal.connect(window.slot());
+        signal.emit(1);
+        signal.emit(2);
+        signal.emit(3);
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        signal.emit(4);
+
+        REQUIRE(window.count() == 1);
+        REQUIRE(window.sum() == 4);
+    }
+}
+
+TEST_CASE("Signal with round robin delivery should call one Slot per emit in turn") {
+    std::vector<int> calls;
+    Signal<> signal;
+    Slot<> slot1([&]() { calls.push_back(1); });
+    Slot<> slot2([&]() { calls.push_back(2); });
+    Slot<> slot3([&]() { calls.push_back(3); });
+
+    signal.connect(slot1);
+    signal.connect(slot2);
+    signal.connect(slot3);
+    signal.setDelivery(Delivery::RoundRobin);
+
+    SECTION("each Slot should be called in turn") {
+        for (int i = 0; i < 6; i++) {
+            signal.emit();
+        }
+
+        REQUIRE(calls == std::vector<int>{1, 2, 3, 1, 2, 3});
+    }
+
+    SECTION("disconnected Slot should no longer be called") {
+        signal.disconnect(slot2);
+        for (int i = 0; i < 4; i++) {
+            signal.emit();
+        }
+
+        REQUIRE(std::count(calls.begin(), calls.end(), 2) == 0);
+        REQUIRE(calls.size() == 4);
+    }
+
+    SECTION("suppressed Slot should pass its turn to the next Slot") {
+        signal.setSampling(slot1, 100);
+        signal.disconnect(slot3);
+        signal.connectOnce(slot3);
+        for (int i = 0; i < 6; i++) {
+            signal.emit();
+        }
+
+        REQUIRE(calls == std::vector<int>{1, 2, 3, 2, 2, 2});
+    }
+
+    SECTION("copied Signal should keep the delivery mode") {
+        Signal<> copy(signal);
+
+        REQUIRE(copy.delivery() == Delivery::RoundRobin);
+    }
+
+    SECTION("Signal without connections should do nothing") {
+        signal.disconnectAll();
+        signal.emit();
+
+        REQUIRE(calls.empty());
+    }
+}
+
+TEST_CASE("Signal with least loaded delivery should call the Slot with the fewest pending deliveries") {
+    EventQueue busy;
+    EventQueue idle;
+    std::vector<int> calls;
+    Signal<int> signal;
+    Slot<int> busySlot(busy, [&](int i) { calls.push_back(i); });
+    Slot<int> idleSlot(idle, [&](int i) { calls.push_back(-i); });
+
+    signal.connect(busySlot);
+    signal.connect(idleSlot);
+    signal.setDelivery(Delivery::LeastLoaded);
+
+    for (int i = 1; i <= 4; i++) {
+        signal.emit(i);
+        idle.dispatch();
+    }
+
+    REQUIRE(busySlot.pendingCount() == 1);
+    REQUIRE(idleSlot.pendingCount() == 0);
+    REQUIRE(calls == std::vector<int>{-2, -3, -4});
+}
+
+TEST_CASE("Signal with random of two delivery should call exactly one Slot per emit") {
+    EventQueue queue;
+    std::vector<int> counts(4);
+    Signal<> signal;
+    std::vector<std::unique_ptr<Slot<>>> slots;
+    for (int i = 0; i < 4; i++) {
+        slots.emplace_back(new Slot<>(queue, [&counts, i]() { ++counts[i]; }));
+        signal.connect(*slots.back());
+    }
+    signal.setDelivery(Delivery::RandomOfTwo);
+
+    for (int i = 0; i < 400; i++) {
+        signal.emit();
+    }
+    queue.dispatch();
+
+    REQUIRE(counts[0] + counts[1] + counts[2] + counts[3] == 400);
+    REQUIRE(*std::max_element(counts.begin(), counts.end()) - *std::min_element(counts.begin(), counts.end()) <= 5);
+}
+
+TEST_CASE("Signal with consistent hash delivery should call the same Slot for the same key") {
+    std::vector<std::unique_ptr<Slot<int>>> slots;
+    std::vector<std::vector<int>> received(4);
+    Signal<int> signal;
+    for (int i = 0; i < 4; i++) {
+        slots.emplace_back(new Slot<int>([&received, i](int key) { received[i].push_back(key); }));
+        signal.connect(*slots.back());
+    }
+    signal.setDelivery([](int key) { return static_cast<std::size_t>(key); });
+
+    auto owners = [&]() {
+        for (auto &keys : received) {
+            keys.clear();
+        }
+        std::vector<int> owner(1000);
+        for (int key = 0; key < 1000; key++) {
+            signal.emit(key);
+        }
+        for (int i = 0; i < 4; i++) {
+            for (auto key : received[i]) {
+                owner[key] = i;
+            }
+        }
+        return owner;
+    };
+
+    auto before = owners();
+
+    SECTION("each key should be delivered to exactly one Slot") {
+        REQUIRE(signal.delivery() == Delivery::ConsistentHash);
+        REQUIRE(received[0].size() + received[1].size() + received[2].size() + received[3].size() == 1000);
+        for (auto &keys : received) {
+            REQUIRE(!keys.empty());
+        }
+    }
+
+    SECTION("same key should be delivered to the same Slot") {
+        REQUIRE(owners() == before);
+    }
+
+    SECTION("destroyed Slot should only move its own keys") {
+        slots[2].reset();
+        auto after = owners();
+
+        REQUIRE(received[2].empty());
+        for (int key = 0; key < 1000; key++) {
+            if (before[key] != 2) {
+                REQUIRE(after[key] == before[key]);
+            }
+        }
+    }
+
+    SECTION("copied Signal should keep the key function") {
+        Signal<int> copy(signal);
+        for (auto &keys : received) {
+            keys.clear();
+        }
+        copy.emit(7);
+
+        REQUIRE(copy.delivery() == Delivery::ConsistentHash);
+        REQUIRE(received[before[7]] == std::vector<int>{7});
+    }
+
+    SECTION("Signal without connections should do nothing") {
+        signal.disconnectAll();
+        for (auto &keys : received) {
+            keys.clear();
+        }
+        signal.emit(1);
+
+        for (auto &keys : received) {
+            REQUIRE(keys.empty());
+        }
+    }
+}
+
+TEST_CASE("consistent hash delivery without a key function should keep the current mode") {
+    int called = 0;
+    Signal<int> signal;
+    Slot<int> first([&](int) { ++called; });
+    Slot<int> second([&](int) { ++called; });
+    signal.connect(first);
+    signal.connect(second);
+
+    signal.setDelivery(Delivery::ConsistentHash);
+    signal.emit(1);
+
+    REQUIRE(signal.delivery() == Delivery::Broadcast);
+    REQUIRE(called == 2);
+
+    SECTION("other delivery mode should be kept") {
+        signal.setDelivery(Delivery::RoundRobin);
+        signal.setDelivery(Delivery::ConsistentHash);
+        called = 0;
+        signal.emit(1);
+
+        REQUIRE(signal.delivery() == Delivery::RoundRobin);
+        REQUIRE(called == 1);
+    }
+
+    SECTION("reselecting consistent hash should keep the key function") {
+        signal.setDelivery([](int key) { return static_cast<std::size_t>(key); });
+        signal.setDelivery(Delivery::ConsistentHash);
+        called = 0;
+        signal.emit(1);
+
+        REQUIRE(signal.delivery() == Delivery::ConsistentHash);
+        REQUIRE(called == 1);
+    }
+}
+
+TEST_CASE("Slot bound to a ThreadPool should run deliveries with the same key in order") {
+    ThreadPool pool(4);
+    std::vector<std::vector<int>> received(8);
+    Signal<int, int> signal;
+    Slot<int, int> slot(pool, [](int key, int) { return static_cast<std::size_t>(key); }, [&](int key, int sequence) {
+        received[key].push_back(sequence);
+    });
+    signal.connect(slot);
+
+    for (int sequence = 0; sequence < 200; sequence++) {
+        for (int key = 0; key < 8; key++) {
+            signal.emit(key, sequence);
+        }
+    }
+    pool.drain();
+
+    REQUIRE(slot.pendingCount() == 0);
+    for (auto &sequences : received) {
+        REQUIRE(sequences.size() == 200);
+        REQUIRE(std::is_sorted(sequences.begin(), sequences.end()));
+    }
+}
+
+TEST_CASE("Slot bound to a ThreadPool should run deliveries with different keys in parallel") {
+    ThreadPool pool(4);
+    std::atomic<int> running{0};
+    std::atomic<int> mostRunning{0};
+    Signal<int> signal;
+    Slot<int> slot(pool, [](int key) { return static_cast<std::size_t>(key); }, [&](int) {
+        auto now = ++running;
+        auto most = mostRunning.load();
+        while (now > most && !mostRunning.compare_exchange_weak(most, now)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        --running;
+    });
+    signal.connect(slot);
+
+    for (int key = 0; key < 64; key++) {
+        signal.emit(key);
+    }
+    pool.drain();
+
+    REQUIRE(mostRunning > 1);
+}
+
+TEST_CASE("ThreadPool should wait for queued deliveries on drain") {
+    std::atomic<int> called{0};
+    Signal<> signal;
+    {
+        ThreadPool pool(2);
+        Slot<> slot(pool, [&]() { ++called; });
+        signal.connect(slot);
+        for (int i = 0; i < 100; i++) {
+            signal.emit();
+        }
+        pool.drain();
+    }
+
+    REQUIRE(called == 100);
+}
+
+TEST_CASE("Slots bound to a Mailbox should never be called concurrently") {
+    ThreadPool pool(4);
+    Mailbox mailbox(pool);
+    int total = 0;
+    std::atomic<bool> inside{false};
+    std::atomic<bool> overlapped{false};
+    auto enter = [&]() {
+        if (inside.exchange(true)) {
+            overlapped = true;
+        }
+    };
+    using ThreadedPolicy = Policy<MutexLocking>;
+    BasicSignal<ThreadedPolicy, int> added;
+    BasicSignal<ThreadedPolicy, int> removed;
+    BasicSlot<ThreadedPolicy, int> add(mailbox, [&](int i) {
+        enter();
+        total += i;
+        inside = false;
+    });
+    BasicSlot<ThreadedPolicy, int> remove(mailbox, [&](int i) {
+        enter();
+        total -= i;
+        inside = false;
+    });
+    added.connect(add);
+    removed.connect(remove);
+
+    std::vector<std::thread> emitters;
+    for (int t = 0; t < 4; t++) {
+        emitters.emplace_back([&, t]() {
+            for (int i = 0; i < 500; i++) {
+                if (t % 2 == 0) {
+                    added.emit(2);
+                } else {
+                    removed.emit(1);
+                }
+            }
+        });
+    }
+    for (auto &emitter : emitters) {
+        emitter.join();
+    }
+    while (add.pendingCount() + remove.pendingCount() > 0) {
+        std::this_thread::yield();
+    }
+    pool.drain();
+
+    REQUIRE(!overlapped);
+    REQUIRE(total == 1000);
+}
+
+TEST_CASE("Mailbox should run consecutive deliveries in batches") {
+    EventQueue queue;
+    Mailbox mailbox(queue, 2);
+    std::vector<int> calls;
+    Signal<int> signal;
+    Slot<int> slot(mailbox, [&](int i) { calls.push_back(i); });
+    signal.connect(slot);
+
+    for (int i = 0; i < 5; i++) {
+        signal.emit(i);
+    }
+
+    REQUIRE(queue.size() == 1);
+    REQUIRE(queue.dispatch() == 1);
+    REQUIRE(calls == std::vector<int>{0, 1});
+    queue.dispatch();
+    queue.dispatch();
+    REQUIRE(calls == std::vector<int>{0, 1, 2, 3, 4});
+    REQUIRE(queue.size() == 0);
+}
+
+TEST_CASE("Graph should propagate a diamond without glitches") {
+    Graph graph;
+    Cell<int> a(graph, 1);
+    Computed<int> doubled(graph, [](int x) { return x * 2; }, a);
+    Computed<int> squared(graph, [](int x) { return x * x; }, a);
+    std::vector<std::pair<int, int>> seen;
+    Computed<int> sum(graph, [&](int d, int s) {
+        seen.emplace_back(d, s);
+        return d + s;
+    }, doubled, squared);
+    std::vector<int> sums;
+    Slot<int> observer([&](int value) { sums.push_back(value); });
+    sum.changed.connect(observer);
+    seen.clear();
+
+    SECTION("each node should be recomputed once with consistent inputs") {
+        a.set(3);
+
+        REQUIRE(seen == std::vector<std::pair<int, int>>{{6, 9}});
+        REQUIRE(graph.recomputeCount() == 3);
+        REQUIRE(sum.get() == 15);
+        REQUIRE(sums == std::vector<int>{15});
+    }
+
+    SECTION("setting an equal value should not propagate") {
+        a.set(1);
+
+        REQUIRE(graph.recomputeCount() == 0);
+        REQUIRE(sums.empty());
+    }
+
+    SECTION("unchanged Computed value should stop propagation") {
+        Cell<int> b(graph, 2);
+        Computed<bool> positive(graph, [](int x) { return x > 0; }, b);
+        int computed = 0;
+        Computed<int> downstream(graph, [&](bool p) {
+            ++computed;
+            return p ? 1 : 0;
+        }, positive);
+        computed = 0;
+
+        b.set(5);
+
+        REQUIRE(computed == 0);
+    }
+
+    SECTION("Cell should be set by a connected Signal") {
+        Signal<int> signal;
+        signal.connect(a.slot());
+        signal.emit(4);
+
+        REQUIRE(sum.get() == 24);
+    }
+}
+
+TEST_CASE("Graph transaction should propagate several Cells in one pass") {
+    Graph graph;
+    Cell<int> width(graph, 1);
+    Cell<int> height(graph, 1);
+    int computed = 0;
+    Computed<int> area(graph, [&](int w, int h) {
+        ++computed;
+        return w * h;
+    }, width, height);
+    std::vector<int> areas;
+    Slot<int> observer([&](int value) { areas.push_back(value); });
+    area.changed.connect(observer);
+    computed = 0;
+
+    graph.transaction([&]() {
+        width.set(3);
+        height.set(4);
+    });
+
+    REQUIRE(computed == 1);
+    REQUIRE(areas == std::vector<int>{12});
+}
+
+TEST_CASE("Graph should keep propagating after a Computed throws") {
+    Graph graph;
+    Cell<int> a(graph, 1);
+    Computed<int> checked(graph, [](int x) {
+        if (x < 0) {
+            throw std::invalid_argument("negative");
+        }
+        return x;
+    }, a);
+
+    REQUIRE_THROWS_AS(a.set(-1), std::invalid_argument);
+
+    a.set(2);
+
+    REQUIRE(checked.get() == 2);
+}
+
+TEST_CASE("Graph should keep notifying after an observer throws") {
+    Graph graph;
+    Cell<int> a(graph, 1);
+    Computed<int> doubled(graph, [](int x) { return x * 2; }, a);
+    std::vector<int> seen;
+    Slot<int> observer([&](int value) {
+        if (value < 0) {
+            throw std::invalid_argument("negative");
+        }
+        seen.push_back(value);
+    });
+    doubled.changed.connect(observer);
+
+    REQUIRE_THROWS_AS(a.set(-1), std::invalid_argument);
+
+    a.set(2);
+
+    REQUIRE(seen == std::vector<int>{4});
+}
+
+TEST_CASE("Property should only emit when its value changes") {
+    Property<int> property(1);
+    std::vector<int> values;
+    Slot<int> observer([&](int value) { values.push_back(value); });
+    property.changed.connect(observer);
+
+    REQUIRE(!property.set(1));
+    REQUIRE(property.set(2));
+    REQUIRE(!property.set(2));
+    REQUIRE(property.get() == 2);
+    REQUIRE(values == std::vector<int>{2});
+}
+
+TEST_CASE("Property should compare with the provided equality") {
+    struct Document {
+        int version;
+        std::string text;
+    };
+    Property<Document> property(Document{1, "a"}, Property<Document>::byKey([](const Document &d) {
+        return d.version;
+    }));
+    int changes = 0;
+    Slot<Document> observer([&](const Document &) { ++changes; });
+    property.changed.connect(observer);
+
+    property.set(Document{1, "ignored"});
+    property.set(Document{2, "b"});
+
+    REQUIRE(changes == 1);
+    REQUIRE(property.get().text == "b");
+}
+
+TEST_CASE("PropertyUpdate should notify each changed Property once at commit") {
+    Property<int> x;
+    Property<int> y;
+    std::vector<std::pair<int, int>> seen;
+    Slot<int> observer([&](int) { seen.emplace_back(x.get(), y.get()); });
+    x.changed.connect(observer);
+    y.changed.connect(observer);
+
+    {
+        PropertyUpdate update;
+        x.set(1);
+        y.set(2);
+        x.set(3);
+
+        REQUIRE(seen.empty());
+
+        {
+            PropertyUpdate nested;
+            y.set(4);
+        }
+
+        REQUIRE(seen.empty());
+    }
+
+    REQUIRE(seen == std::vector<std::pair<int, int>>{{3, 4}, {3, 4}});
+
+    SECTION("Property destroyed before commit should not be notified") {
+        seen.clear();
+        PropertyUpdate update;
+        {
+            Property<int> temporary;
+            temporary.changed.connect(observer);
+            temporary.set(5);
+        }
+        x.set(6);
+        update.commit();
+
+        REQUIRE(seen.size() == 1);
+    }
+
+    SECTION("throwing observer should not stop later updates from notifying") {
+        seen.clear();
+        Property<int> failing;
+        Slot<int> thrower([](int) { throw std::runtime_error("failed"); });
+        failing.changed.connect(thrower);
+        PropertyUpdate update;
+        failing.set(1);
+        x.set(7);
+
+        REQUIRE_THROWS_AS(update.commit(), std::runtime_error);
+        REQUIRE(seen.empty());
+
+        {
+            PropertyUpdate next;
+            y.set(8);
+        }
+
+        REQUIRE(seen == std::vector<std::pair<int, int>>{{7, 8}, {7, 8}});
+    }
+}
+
+TEST_CASE("Memo should recompute lazily after its inputs emit") {
+    int base = 2;
+    int computed = 0;
+    Signal<int> baseChanged;
+    Signal<> reset;
+    Memo<int> squared([&]() {
+        ++computed;
+        return base * base;
+    }, baseChanged, reset);
+
+    REQUIRE(squared.isDirty());
+    REQUIRE(squared.get() == 4);
+    REQUIRE(squared.get() == 4);
+    REQUIRE(computed == 1);
+
+    SECTION("emissions should only mark the value dirty") {
+        base = 3;
+        baseChanged.emit(3);
+        reset.emit();
+
+        REQUIRE(computed == 1);
+        REQUIRE(squared.isDirty());
+        REQUIRE(squared.get() == 9);
+        REQUIRE(computed == 2);
+    }
+
+    SECTION("dependent Memo should only be invalidated once until read") {
+        int invalidations = 0;
+        Memo<int> plusOne([&]() { return squared.get() + 1; }, squared.invalidated);
+        Slot<> counter([&]() { ++invalidations; });
+        plusOne.invalidated.connect(counter);
+
+        REQUIRE(plusOne.get() == 5);
+
+        base = 4;
+        baseChanged.emit(4);
+        baseChanged.emit(4);
+        baseChanged.emit(4);
+
+        REQUIRE(invalidations == 1);
+        REQUIRE(plusOne.get() == 17);
+        REQUIRE(computed == 2);
+    }
+}
+
+TEST_CASE("Transaction should deliver recorded emissions in order on commit") {
+    std::vector<std::string> calls;
+    Signal<int> all;
+    Signal<int> last;
+    Signal<int> merged;
+    Slot<int> allSlot([&](int i) { calls.push_back("all " + std::to_string(i)); });
+    Slot<int> lastSlot([&](int i) { calls.push_back("last " + std::to_string(i)); });
+    Slot<int> mergedSlot([&](int i) { calls.push_back("merged " + std::to_string(i)); });
+    all.connect(allSlot);
+    last.connect(lastSlot);
+    merged.connect(mergedSlot);
+    last.setCoalescing(Coalesce::KeepLast);
+    merged.setCoalescing([](std::tuple<int> &pending, int i) { std::get<0>(pending) += i; });
+
+    {
+        Transaction transaction;
+        last.emit(1);
+        all.emit(1);
+        merged.emit(1);
+        last.emit(2);
+        all.emit(2);
+        merged.emit(2);
+
+        REQUIRE(calls.empty());
+
+        {
+            Transaction nested;
+            merged.emit(3);
+        }
+
+        REQUIRE(calls.empty());
+    }
+
+    REQUIRE(calls == std::vector<std::string>{"last 2", "all 1", "merged 6", "all 2"});
+
+    SECTION("emissions after commit should be delivered immediately") {
+        calls.clear();
+        last.emit(3);
+
+        REQUIRE(calls == std::vector<std::string>{"last 3"});
+    }
+
+    SECTION("Signal destroyed before commit should not be delivered") {
+        calls.clear();
+        Transaction transaction;
+        {
+            Signal<int> temporary;
+            temporary.connect(allSlot);
+            temporary.emit(9);
+        }
+        all.emit(4);
+        transaction.commit();
+
+        REQUIRE(calls == std::vector<std::string>{"all 4"});
+    }
+
+    SECTION("throwing Slot should keep undelivered emissions for the next commit") {
+        calls.clear();
+        Signal<int> failing;
+        Slot<int> thrower([](int) { throw std::runtime_error("failed"); });
+        failing.connect(thrower);
+        Transaction transaction;
+        failing.emit(1);
+        all.emit(5);
+
+        REQUIRE_THROWS_AS(transaction.commit(), std::runtime_error);
+        REQUIRE(calls.empty());
+
+        {
+            Transaction next;
+            all.emit(6);
+        }
+
+        REQUIRE(calls == std::vector<std::string>{"all 5", "all 6"});
+    }
+}
+
+TEST_CASE("paused Signal should buffer emissions until resumed") {
+    std::vector<int> calls;
+    Signal<int> signal;
+    Slot<int> slot([&](int i) { calls.push_back(i); });
+    signal.connect(slot);
+
+    signal.pause();
+    signal.emit(1);
+    signal.emit(2);
+    signal.emit(3);
+
+    REQUIRE(signal.isPaused());
+    REQUIRE(signal.bufferedCount() == 3);
+    REQUIRE(calls.empty());
+    REQUIRE(slot.isConnectedTo(signal));
+
+    SECTION("resume should deliver buffered emissions in order") {
+        signal.resume();
+        signal.emit(4);
+
+        REQUIRE(!signal.isPaused());
+        REQUIRE(signal.bufferedCount() == 0);
+        REQUIRE(calls == std::vector<int>{1, 2, 3, 4});
+    }
+
+    SECTION("coalesced Signal should buffer one emission") {
+        signal.resume();
+        calls.clear();
+        signal.setCoalescing(Coalesce::KeepLast);
+        signal.pause();
+        signal.emit(5);
+        signal.emit(6);
+
+        REQUIRE(signal.bufferedCount() == 1);
+
+        signal.resume();
+
+        REQUIRE(calls == std::vector<int>{6});
+    }
+
+    SECTION("moved Signal should stay paused and keep buffered emissions") {
+        Signal<int> moved(std::move(signal));
+
+        REQUIRE(moved.isPaused());
+        REQUIRE(moved.bufferedCount() == 3);
+        REQUIRE(!signal.isPaused());
+        REQUIRE(signal.bufferedCount() == 0);
+
+        moved.resume();
+
+        REQUIRE(calls == std::vector<int>{1, 2, 3});
+    }
+}
+
+TEST_CASE("FrameDispatcher should deliver a frame of emissions grouped by Slot") {
+    FrameDispatcher frame;
+    std::vector<std::string> calls;
+    Signal<int> input;
+    Signal<int> network;
+    Slot<int> first([&](int i) { calls.push_back("first " + std::to_string(i)); });
+    Slot<int> second([&](int i) { calls.push_back("second " + std::to_string(i)); });
+    Slot<int> received([&](int i) { calls.push_back("received " + std::to_string(i)); });
+    input.connect(first);
+    input.connect(second);
+    network.connect(received);
+    input.setDispatcher(&frame);
+    network.setDispatcher(&frame);
+
+    network.emit(1);
+    input.emit(2);
+    input.emit(3);
+
+    REQUIRE(calls.empty());
+    REQUIRE(frame.size() == 2);
+    REQUIRE(frame.dispatch() == 2);
+    REQUIRE(calls == std::vector<std::string>{"received 1", "first 2", "first 3", "second 2", "second 3"});
+
+    SECTION("next frame should start empty") {
+        calls.clear();
+
+        REQUIRE(frame.dispatch() == 0);
+        REQUIRE(calls.empty());
+    }
+
+    SECTION("detached Signal should deliver collected emissions immediately") {
+        calls.clear();
+        network.emit(4);
+        network.setDispatcher(nullptr);
+
+        REQUIRE(calls == std::vector<std::string>{"received 4"});
+
+        network.emit(5);
+
+        REQUIRE(calls == std::vector<std::string>{"received 4", "received 5"});
+        REQUIRE(frame.dispatch() == 0);
+    }
+
+    SECTION("Signal destroyed before dispatch should not be delivered") {
+        calls.clear();
+        {
+            Signal<int> temporary;
+            temporary.connect(first);
+            temporary.setDispatcher(&frame);
+            temporary.emit(6);
+        }
+
+        REQUIRE(frame.dispatch() == 0);
+        REQUIRE(calls.empty());
+    }
+}
+
+TEST_CASE("queued Slots of a frame should share one copy of the arguments per emission") {
+    struct CopyCounter {
+        int *copies;
+
+        explicit CopyCounter(int *copies) : copies(copies) {}
+
+        CopyCounter(const CopyCounter &other) : copies(other.copies) { ++*copies; }
+
+        CopyCounter(CopyCounter &&other) noexcept : copies(other.copies) {}
+    };
+
+    int copies = 0;
+    int called = 0;
+    FrameDispatcher frame;
+    EventQueue queue;
+    Signal<CopyCounter> signal;
+    Slot<CopyCounter> queued1(queue, [&](const CopyCounter &) { ++called; });
+    Slot<CopyCounter> queued2(queue, [&](const CopyCounter &) { ++called; });
+    Slot<CopyCounter> queued3(queue, [&](const CopyCounter &) { ++called; });
+    signal.connect(queued1);
+    signal.connect(queued2);
+    signal.connect(queued3);
+    signal.setDispatcher(&frame);
+
+    signal.emit(CopyCounter(&copies));
+    signal.emit(CopyCounter(&copies));
+    auto recorded = copies;
+    frame.dispatch();
+    queue.dispatch();
+
+    REQUIRE(called == 6);
+    REQUIRE(copies - recorded == 2);
+}
+
+TEST_CASE("emitUntilStopped should stop at the first Slot returning Stop") {
+    std::vector<std::string> calls;
+    Signal<int> button;
+    Signal<int> panel;
+    Signal<int> window;
+    button.setParent(&panel);
+    panel.setParent(&window);
+    Slot<int> logger([&](int) { calls.push_back("logger"); });
+    Slot<int> buttonHandler([&](int key) {
+        calls.push_back("button");
+        return key == 1 ? Propagation::Stop : Propagation::Continue;
+    });
+    Slot<int> panelHandler([&](int key) {
+        calls.push_back("panel");
+        return key == 2 ? Propagation::Stop : Propagation::Continue;
+    });
+    Slot<int> windowHandler([&](int) { calls.push_back("window"); });
+    Slot<int> unreached([&](int) { calls.push_back("unreached"); });
+    button.connect(logger);
+    button.connect(buttonHandler);
+    button.connect(unreached);
+    panel.connect(panelHandler);
+    window.connect(windowHandler);
+
+    SECTION("Slots after the one that stopped should not be called") {
+        REQUIRE(button.emitUntilStopped(1));
+        REQUIRE(calls == std::vector<std::string>{"logger", "button"});
+    }
+
+    SECTION("unhandled emission should bubble to the parent Signals") {
+        REQUIRE(button.emitUntilStopped(2));
+        REQUIRE(calls == std::vector<std::string>{"logger", "button", "unreached", "panel"});
+    }
+
+    SECTION("emission handled by no Slot should reach the root") {
+        REQUIRE(!button.emitUntilStopped(3));
+        REQUIRE(calls == std::vector<std::string>{"logger", "button", "unreached", "panel", "window"});
+    }
+
+    SECTION("emit should call every Slot and not bubble") {
+        button.emit(1);
+
+        REQUIRE(calls == std::vector<std::string>{"logger", "button", "unreached"});
+    }
+
+    SECTION("Slot stopping a nested emit should not stop the enclosing chain") {
+        Signal<int> other;
+        Slot<int> stopper([&](int) {
+            calls.push_back("stopper");
+            return Propagation::Stop;
+        });
+        other.connect(stopper);
+        Slot<int> forwarder([&](int key) {
+            calls.push_back("forwarder");
+            other.emit(key);
+        });
+        button.disconnect(logger);
+        button.disconnect(buttonHandler);
+        button.disconnect(unreached);
+        button.connect(forwarder);
+        button.connect(unreached);
+
+        REQUIRE(!button.emitUntilStopped(3));
+        REQUIRE(calls == std::vector<std::string>{"forwarder", "stopper", "unreached", "panel", "window"});
+    }
+}
+
+TEST_CASE("Signal should suppress deliveries by per connection sampling and rate limit") {
+    std::vector<int> sampled;
+    std::vector<int> limited;
+    std::vector<int> unfiltered;
+    Signal<int> signal;
+    Slot<int> sampler([&](int i) { sampled.push_back(i); });
+    Slot<int> limiter([&](int i) { limited.push_back(i); });
+    Slot<int> plain([&](int i) { unfiltered.push_back(i); });
+    signal.connect(sampler);
+    signal.connect(limiter);
+    signal.connect(plain);
+    signal.setSampling(sampler, 3);
+    signal.setRateLimit(limiter, 0.001, 2);
+
+    for (int i = 0; i < 9; i++) {
+        signal.emit(i);
+    }
+
+    REQUIRE(sampled == std::vector<int>{0, 3, 6});
+    REQUIRE(limited == std::vector<int>{0, 1});
+    REQUIRE(unfiltered.size() == 9);
+    REQUIRE(signal.suppressedCount(sampler) == 6);
+    REQUIRE(signal.suppressedCount(limiter) == 7);
+    REQUIRE(signal.suppressedCount(plain) == 0);
+
+    SECTION("disconnecting should drop the filter") {
+        signal.disconnect(sampler);
+        signal.connect(sampler);
+        signal.emit(9);
+
+        REQUIRE(signal.suppressedCount(sampler) == 0);
+        REQUIRE(sampled.back() == 9);
+    }
+
+    SECTION("filter of an unconnected Slot should be ignored") {
+        Slot<int> other([](int) {});
+        signal.setSampling(other, 2);
+
+        REQUIRE(signal.suppressedCount(other) == 0);
+    }
+
+    SECTION("moved Slot should keep its filter") {
+        Slot<int> moved(std::move(sampler));
+        sampled.clear();
+        for (int i = 9; i < 15; i++) {
+            signal.emit(i);
+        }
+
+        REQUIRE(sampled == std::vector<int>{9, 12});
+        REQUIRE(signal.suppressedCount(moved) == 10);
+    }
+
+    SECTION("copied Signal should keep the filters") {
+        Signal<int> copy(signal);
+        sampled.clear();
+        limited.clear();
+        for (int i = 0; i < 6; i++) {
+            copy.emit(i);
+        }
+
+        REQUIRE(sampled == std::vector<int>{0, 3});
+        REQUIRE(limited.empty());
+    }
+}
+
+TEST_CASE("Signal should disconnect one-shot and N-shot connections once used") {
+    std::vector<std::string> calls;
+    Signal<> signal;
+    Slot<> once([&]() { calls.push_back("once"); });
+    Slot<> twice([&]() { calls.push_back("twice"); });
+    Slot<> always([&]() { calls.push_back("always"); });
+    signal.connectOnce(once);
+    signal.connectFor(twice, 2);
+    signal.connect(always);
+
+    signal.emit();
+    signal.emit();
+    signal.emit();
+
+    REQUIRE(calls == std::vector<std::string>{"once", "twice", "always", "twice", "always", "always"});
+    REQUIRE(!once.isConnectedTo(signal));
+    REQUIRE(!twice.isConnectedTo(signal));
+    REQUIRE(signal.connectionCount() == 1);
+
+    SECTION("one-shot Slot re-emitting should not be called again") {
+        calls.clear();
+        Slot<> reentrant([&]() {
+            calls.push_back("reentrant");
+            signal.emit();
+        });
+        signal.connectOnce(reentrant);
+        signal.emit();
+
+        REQUIRE(calls == std::vector<std::string>{"always", "reentrant", "always"});
+        REQUIRE(!reentrant.isConnectedTo(signal));
+    }
+
+    SECTION("one-shot Slot should be able to reconnect") {
+        signal.connectOnce(once);
+        signal.emit();
+
+        REQUIRE(std::count(calls.begin(), calls.end(), "once") == 2);
+        REQUIRE(!once.isConnectedTo(signal));
+    }
+
+    SECTION("one-shot connection should expire after a throwing Slot") {
+        calls.clear();
+        Slot<> throwing([]() { throw std::runtime_error("failed"); });
+        signal.connect(throwing);
+        REQUIRE_THROWS_AS(signal.emit(), std::runtime_error);
+        signal.disconnect(throwing);
+        signal.connectOnce(once);
+        signal.emit();
+        signal.emit();
+
+        REQUIRE(std::count(calls.begin(), calls.end(), "once") == 1);
+        REQUIRE(!once.isConnectedTo(signal));
+        REQUIRE(signal.connectionCount() == 1);
+    }
+
+    SECTION("moved one-shot Slot should stay one-shot") {
+        calls.clear();
+        signal.connectOnce(once);
+        Slot<> moved(std::move(once));
+        signal.emit();
+        signal.emit();
+
+        REQUIRE(std::count(calls.begin(), calls.end(), "once") == 1);
+        REQUIRE(!moved.isConnectedTo(signal));
+        REQUIRE(signal.connectionCount() == 1);
+    }
+
+    SECTION("Slot moved after its last delivery should not be reconnected") {
+        calls.clear();
+        std::unique_ptr<Slot<>> moved;
+        Slot<> mover([&]() { moved.reset(new Slot<>(std::move(once))); });
+        signal.connectOnce(once);
+        signal.connectOnce(mover);
+        signal.emit();
+        signal.emit();
+
+        REQUIRE(std::count(calls.begin(), calls.end(), "once") == 1);
+        REQUIRE(!moved->isConnectedTo(signal));
+        REQUIRE(signal.connectionCount() == 1);
+    }
+
+    SECTION("one-shot Slot re-arming itself should stay connected until it stops") {
+        calls.clear();
+        int rearms = 2;
+        Slot<> *self = nullptr;
+        Slot<> rearming([&]() {
+            calls.push_back("rearming");
+            if (rearms-- > 0) {
+                signal.connectOnce(*self);
+            }
+        });
+        self = &rearming;
+        signal.connectOnce(rearming);
+
+        signal.emit();
+        signal.emit();
+        REQUIRE(rearming.isConnectedTo(signal));
+        signal.emit();
+        signal.emit();
+
+        REQUIRE(std::count(calls.begin(), calls.end(), "rearming") == 3);
+        REQUIRE(!rearming.isConnectedTo(signal));
+        REQUIRE(signal.connectionCount() == 1);
+    }
+}
+
+TEST_CASE("moving a Slot bound to a ThreadPool should wait for running deliveries") {
+    ThreadPool pool(2);
+    std::atomic<bool> started{false};
+    std::atomic<bool> finished{false};
+    Signal<> signal;
+    Slot<> slot(pool, [&]() {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        finished = true;
+    });
+    signal.connect(slot);
+    signal.emit();
+    while (!started) {
+        std::this_thread::yield();
+    }
+
+    Slot<> moved(std::move(slot));
+
+    REQUIRE(finished);
+    REQUIRE(moved.isConnectedTo(signal));
+    pool.drain();
+}